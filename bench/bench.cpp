@@ -1,10 +1,12 @@
 #include <benchmark/benchmark.h>
 
 #include <algorithm>
+#include <charconv>
 #include <noam/co_await.hpp>
 #include <noam/combinators.hpp>
 #include <noam/intrinsics.hpp>
 #include <random>
+#include <string>
 #include <vector>
 
 constexpr noam::state_t sequence_input =
@@ -261,6 +263,10 @@ constexpr parser_test test_add {
     15998326,
     1000};
 
+// A long run of indentation, which count_spaces should skip a block at a time
+std::string const indentation = std::string(4096, ' ') + "x";
+parser_test const test_count_spaces {indentation, "x", size_t(4096)};
+
 void BM_parser(benchmark::State& state, auto parser, auto test) {
     for (auto _ : state) {
         // Validate that the parse result was successful
@@ -275,9 +281,74 @@ void BM_parser(benchmark::State& state, auto parser, auto test) {
     }
 }
 
+/**
+ * @brief Space-separated random integers with the given number of digits
+ */
+std::string make_ints(int digits) {
+    std::mt19937_64 gen(42);
+    std::string str;
+    for (int i = 0; i < 1000; i++) {
+        str += char('1' + gen() % 9);
+        for (int j = 1; j < digits; j++) {
+            str += char('0' + gen() % 10);
+        }
+        str += ' ';
+    }
+    return str;
+}
+
+/**
+ * @brief Parses every integer in the input with the given function, which
+ * returns the remaining input. Reports the number of integers parsed.
+ */
+void BM_parse_ints(benchmark::State& state, auto parse_one) {
+    std::string input = make_ints(state.range(0));
+    for (auto _ : state) {
+        noam::state_t st = input;
+        while (!st.empty()) {
+            st = parse_one(st);
+            st.remove_prefix(1);
+        }
+        benchmark::DoNotOptimize(st);
+    }
+    state.SetItemsProcessed(1000 * state.iterations());
+}
+
+template <auto& parser>
+noam::state_t parse_with(noam::state_t st) {
+    auto result = parser.parse(st);
+    benchmark::DoNotOptimize(result.get_value());
+    return result.get_state();
+}
+
+noam::state_t parse_with_from_chars(noam::state_t st) {
+    unsigned long value;
+    auto result = std::from_chars(st.begin(), st.end(), value);
+    benchmark::DoNotOptimize(value);
+    return {result.ptr, st.end()};
+}
+
+BENCHMARK_CAPTURE(BM_parse_ints, from_chars, parse_with_from_chars)
+    ->DenseRange(2, 18, 4)
+    ->Arg(19);
+BENCHMARK_CAPTURE(BM_parse_ints, parse_ulong, parse_with<noam::parse_ulong>)
+    ->DenseRange(2, 18, 4)
+    ->Arg(19);
+BENCHMARK_CAPTURE(
+    BM_parse_ints,
+    parse_ulong_unchecked,
+    parse_with<noam::parse_charconv_unchecked<unsigned long>>)
+    ->DenseRange(2, 18, 4)
+    ->Arg(19);
+
 BENCHMARK_CAPTURE(BM_parser, add_w_try_parse, add_w_try_parse, test_add);
 BENCHMARK_CAPTURE(BM_parser, add_w_test_then, add_w_test_then, test_add);
 BENCHMARK_CAPTURE(BM_parser, add_w_fold, add_w_fold, test_add);
 BENCHMARK_CAPTURE(BM_parser, add_w_baseline, add_w_baseline, test_add);
+BENCHMARK_CAPTURE(
+    BM_parser,
+    count_spaces,
+    noam::count_spaces,
+    test_count_spaces);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include <noam/intrinsics.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief A run of random characters from `members`, followed by a character
+ * which ends the run
+ */
+std::string make_run(size_t length, std::string_view members) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> member(0, members.size() - 1);
+    std::string str;
+    for (size_t i = 0; i < length; i++) {
+        str += members[member(gen)];
+    }
+    str += ' ';
+    return str;
+}
+
+constexpr std::string_view identifier_chars =
+    "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_";
+
+/**
+ * @brief Runs the given function, which returns the length of the run, on a
+ * run of characters from `members`
+ */
+void BM_run(benchmark::State& state, std::string_view members, auto scan) {
+    std::string input = make_run(state.range(0), members);
+    for (auto _ : state) {
+        size_t length = scan(noam::state_t(input));
+        if (length != input.size() - 1) {
+            throw std::runtime_error("Scan failed");
+        }
+        benchmark::DoNotOptimize(length);
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+size_t scan_many_of(noam::state_t input) {
+    return noam::many_of<noam::char_classes::identifier>.parse(input)
+        .get_value()
+        .size();
+}
+
+// A table lookup per byte, without SIMD
+size_t scan_table(noam::state_t input) {
+    size_t size = input.size();
+    size_t i = 0;
+    while (i < size && noam::char_classes::identifier.contains(input[i]))
+        i++;
+    return i;
+}
+
+// Range comparisons per byte, as a hand-written scanner would do
+size_t scan_ranges(noam::state_t input) {
+    size_t size = input.size();
+    size_t i = 0;
+    for (; i < size; i++) {
+        char ch = input[i];
+        bool in_class = ('a' <= ch && ch <= 'z') || ('A' <= ch && ch <= 'Z')
+                     || ('0' <= ch && ch <= '9') || ch == '_';
+        if (!in_class)
+            break;
+    }
+    return i;
+}
+
+size_t scan_digits_many_of(noam::state_t input) {
+    return noam::many_of<noam::char_classes::digit>.parse(input)
+        .get_value()
+        .size();
+}
+
+template <char... chars>
+bool is_any(char ch) {
+    return ((ch == chars) || ...);
+}
+
+// An equality test per character in the set, which is how a fold over
+// match_ch<'0', ..., '9'> checks each byte
+size_t scan_digits_fold(noam::state_t input) {
+    size_t size = input.size();
+    size_t i = 0;
+    while (i < size
+           && is_any<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'>(
+               input[i]))
+        i++;
+    return i;
+}
+
+BENCHMARK_CAPTURE(BM_run, identifier_many_of, identifier_chars, scan_many_of)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(1024);
+BENCHMARK_CAPTURE(BM_run, identifier_table, identifier_chars, scan_table)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(1024);
+BENCHMARK_CAPTURE(BM_run, identifier_ranges, identifier_chars, scan_ranges)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(1024);
+BENCHMARK_CAPTURE(BM_run, digits_many_of, "0123456789", scan_digits_many_of)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(1024);
+BENCHMARK_CAPTURE(BM_run, digits_fold, "0123456789", scan_digits_fold)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <noam/co_await.hpp>
+#include <noam/combinators.hpp>
+#include <noam/intrinsics.hpp>
+
+// Count every call to the global allocator, so that we can report how many
+// heap allocations each parse performs
+static std::atomic<size_t> allocation_count = 0;
+
+// GCC sees operator new's memory being released with std::free, which is
+// what these replacements are meant to do
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, std::align_val_t align) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    size_t alignment = size_t(align);
+    size = (size + alignment - 1) / alignment * alignment;
+    if (void* ptr = std::aligned_alloc(alignment, size ? size : alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+struct point {
+    int x = 0;
+    int y = 0;
+};
+
+// A small coroutine parser, of the kind that gets invoked once per record
+constexpr noam::parser parse_point = [](noam::state_t) -> noam::result<point> {
+    co_await noam::literal<'('>;
+    int x = co_await noam::parse_int;
+    co_await noam::comma_separator;
+    int y = co_await noam::parse_int;
+    co_await noam::literal<')'>;
+    co_return point {x, y};
+} / noam::make_parser;
+
+constexpr noam::state_t point_input = "(1234, -5678)";
+
+/**
+ * @brief Parses a point over and over again, with coroutine frames allocated
+ * from `resource` (or from the thread-local frame pool if resource is null)
+ */
+void BM_coroutine_frames(
+    benchmark::State& state,
+    std::pmr::memory_resource* resource) {
+    noam::scoped_frame_resource scope {resource};
+    size_t start_count = allocation_count.load();
+    for (auto _ : state) {
+        auto result = parse_point.parse(point_input);
+        if (!result) {
+            throw std::runtime_error("Parse failed");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    size_t allocations = allocation_count.load() - start_count;
+    state.counters["allocs_per_parse"] = double(allocations)
+                                       / double(state.iterations());
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Parses a point over and over again, with coroutine frames allocated
+ * from a fixed-size arena that gets released every 64 parses
+ */
+void BM_coroutine_frames_arena(benchmark::State& state) {
+    alignas(std::max_align_t) static char buffer[1 << 16];
+    std::pmr::monotonic_buffer_resource arena {
+        buffer,
+        sizeof(buffer),
+        std::pmr::null_memory_resource()};
+    noam::scoped_frame_resource scope {&arena};
+    size_t start_count = allocation_count.load();
+    size_t parses = 0;
+    for (auto _ : state) {
+        auto result = parse_point.parse(point_input);
+        if (!result) {
+            throw std::runtime_error("Parse failed");
+        }
+        benchmark::DoNotOptimize(result);
+        if (++parses % 64 == 0) {
+            arena.release();
+        }
+    }
+    size_t allocations = allocation_count.load() - start_count;
+    state.counters["allocs_per_parse"] = double(allocations)
+                                       / double(state.iterations());
+    state.SetItemsProcessed(state.iterations());
+}
+
+// new_delete_resource forwards every frame to the global heap, which matches
+// the behavior before frames were pooled
+BENCHMARK_CAPTURE(
+    BM_coroutine_frames,
+    heap,
+    std::pmr::new_delete_resource());
+BENCHMARK_CAPTURE(BM_coroutine_frames, pool, nullptr);
+BENCHMARK(BM_coroutine_frames_arena);
+
+BENCHMARK_MAIN();
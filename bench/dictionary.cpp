@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+
+#include <noam/combinators.hpp>
+#include <noam/dictionary.hpp>
+#include <noam/intrinsics.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Random product codes, such as "KX-40213". Codes vary in length, so
+ * many codes are prefixes of longer ones.
+ */
+std::vector<std::string> make_codes(size_t count) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> letter('A', 'Z');
+    std::uniform_int_distribution<int> digit('0', '9');
+    std::uniform_int_distribution<int> digits(1, 6);
+    std::vector<std::string> codes;
+    for (size_t i = 0; i < count; i++) {
+        std::string code {char(letter(gen)), char(letter(gen)), '-'};
+        for (int d = digits(gen); d > 0; d--) {
+            code += char(digit(gen));
+        }
+        codes.push_back(code);
+    }
+    return codes;
+}
+
+/**
+ * @brief 1000 codes drawn from the vocabulary, each followed by a space
+ */
+std::string make_input(std::vector<std::string> const& codes) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<size_t> code(0, codes.size() - 1);
+    std::string str;
+    for (int i = 0; i < 1000; i++) {
+        str += codes[code(gen)];
+        str += ' ';
+    }
+    return str;
+}
+
+void BM_codes(benchmark::State& state, auto const& parser, std::string input) {
+    for (auto _ : state) {
+        noam::state_t st = input;
+        while (!st.empty()) {
+            auto result = parser.parse(st);
+            if (!result) {
+                throw std::runtime_error("Parse failed");
+            }
+            st = result.get_state();
+            st.remove_prefix(1);
+        }
+        benchmark::DoNotOptimize(st);
+    }
+    state.SetItemsProcessed(1000 * state.iterations());
+}
+
+// 16 field names, none of which is a prefix of another, so either's ordered
+// choice finds the same word as the longest match
+#define FIELD_NAMES                                                            \
+    "id", "name", "price", "currency", "quantity", "warehouse", "supplier",    \
+        "category", "weight", "height", "width", "depth", "color", "brand",    \
+        "barcode", "created"
+
+void BM_fields_either(benchmark::State& state) {
+    auto field = [](auto... names) {
+        return noam::either(noam::require_prefix(names)...);
+    }(FIELD_NAMES);
+    BM_codes(state, field, make_input({FIELD_NAMES}));
+}
+void BM_fields_dictionary(benchmark::State& state) {
+    noam::dictionary fields {FIELD_NAMES};
+    BM_codes(state, noam::parse_dictionary(fields), make_input({FIELD_NAMES}));
+}
+
+/**
+ * @brief Tries each code in turn with require_prefix, keeping the longest
+ * match. This is what a chain of either alternatives does, but a chain has to
+ * be written out at compile time.
+ */
+struct linear_search {
+    std::vector<std::string> codes;
+    auto parse(noam::state_t st) const -> noam::result<size_t> {
+        noam::result<size_t> best;
+        for (size_t id = 0; id < codes.size(); id++) {
+            auto r = noam::require_prefix(codes[id]).parse(st);
+            if (!r) {
+                continue;
+            }
+            if (!best || r.get_state().size() < best.get_state().size()) {
+                best = {r.get_state(), id};
+            }
+        }
+        return best;
+    }
+};
+
+void BM_codes_linear(benchmark::State& state) {
+    auto codes = make_codes(state.range(0));
+    BM_codes(state, linear_search {codes}, make_input(codes));
+}
+void BM_codes_dictionary(benchmark::State& state) {
+    auto codes = make_codes(state.range(0));
+    noam::dictionary dict(codes);
+    BM_codes(state, noam::parse_dictionary(dict), make_input(codes));
+}
+void BM_codes_build(benchmark::State& state) {
+    auto codes = make_codes(state.range(0));
+    for (auto _ : state) {
+        noam::dictionary dict(codes);
+        benchmark::DoNotOptimize(dict);
+    }
+    state.SetItemsProcessed(codes.size() * state.iterations());
+}
+
+BENCHMARK(BM_fields_either);
+BENCHMARK(BM_fields_dictionary);
+BENCHMARK(BM_codes_linear)->Arg(1024);
+BENCHMARK(BM_codes_dictionary)->Arg(1024)->Arg(200000);
+BENCHMARK(BM_codes_build)->Arg(1024)->Arg(200000);
+
+BENCHMARK_MAIN();
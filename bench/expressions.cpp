@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <noam/combinators.hpp>
+#include <noam/intrinsics.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// Integer expressions with ten of C's precedence tiers, from loosest to
+// tightest: ||, &&, |, ^, &, ==, <, <<, + and -, *, and unary -. Arithmetic
+// wraps, so any expression has a value.
+
+constexpr noam::parser open_paren = noam::literal<'('>;
+constexpr noam::parser close_paren = noam::literal<')'>;
+
+constexpr auto logical_or = [](uint64_t a, uint64_t b) -> uint64_t {
+    return a || b;
+};
+constexpr auto logical_and = [](uint64_t a, uint64_t b) -> uint64_t {
+    return a && b;
+};
+constexpr auto equal = [](uint64_t a, uint64_t b) -> uint64_t {
+    return a == b;
+};
+constexpr auto less = [](uint64_t a, uint64_t b) -> uint64_t {
+    return a < b;
+};
+constexpr auto shift = [](uint64_t a, uint64_t b) -> uint64_t {
+    return a << (b & 63);
+};
+
+/**
+ * @brief One fold_left parser per tier. Each operand is parsed through every
+ * tier, from the loosest down.
+ */
+constexpr noam::parser tower = noam::recurse<uint64_t>([](auto self) {
+    using namespace noam;
+    auto primary = either(parse_uint64, enclose(open_paren, self, close_paren));
+    auto unary = either(
+        map(std::negate<> {}, join(literal<'-'>, primary)),
+        primary);
+    auto product = fold_left(
+        unary,
+        join(literal<'*'>, unary),
+        std::multiplies<> {});
+    auto sum = fold_left(
+        product,
+        either(
+            join(literal<'+'>, product),
+            map(std::negate<> {}, join(literal<'-'>, product))),
+        std::plus<> {});
+    auto shifted = fold_left(sum, join(literal<"<<">, sum), shift);
+    auto compared = fold_left(shifted, join(literal<'<'>, shifted), less);
+    auto equality = fold_left(compared, join(literal<"==">, compared), equal);
+    auto bit_and = fold_left(
+        equality,
+        join(literal<'&'>, equality),
+        std::bit_and<> {});
+    auto bit_xor = fold_left(
+        bit_and,
+        join(literal<'^'>, bit_and),
+        std::bit_xor<> {});
+    auto bit_or = fold_left(
+        bit_xor,
+        join(literal<'|'>, bit_xor),
+        std::bit_or<> {});
+    auto all = fold_left(bit_or, join(literal<"&&">, bit_or), logical_and);
+    return fold_left(all, join(literal<"||">, all), logical_or);
+});
+
+// Operators sharing a first byte are tried in order, so "||" comes before
+// "|", and so on
+constexpr auto c_operators = noam::operator_table(
+    noam::infix_op<"||", 1>(logical_or),
+    noam::infix_op<"&&", 2>(logical_and),
+    noam::infix_op<'|', 3>(std::bit_or<> {}),
+    noam::infix_op<'^', 4>(std::bit_xor<> {}),
+    noam::infix_op<'&', 5>(std::bit_and<> {}),
+    noam::infix_op<"==", 6>(equal),
+    noam::infix_op<"<<", 8>(shift),
+    noam::infix_op<'<', 7>(less),
+    noam::infix_op<'+', 9>(std::plus<> {}),
+    noam::infix_op<'-', 9>(std::minus<> {}),
+    noam::infix_op<'*', 10>(std::multiplies<> {}),
+    noam::prefix_op<'-', 11>(std::negate<> {}));
+
+constexpr noam::parser pratt = noam::recurse<uint64_t>([](auto self) {
+    return noam::pratt(
+        noam::either(
+            noam::parse_uint64,
+            noam::enclose(open_paren, self, close_paren)),
+        c_operators);
+});
+
+/**
+ * @brief A random expression with `count` operands. Some operands are negated,
+ * and some are parenthesized subexpressions.
+ */
+void append_expression(std::string& str, std::mt19937& gen, int count) {
+    constexpr char const* ops[] {
+        "||", "&&", "|", "^", "&", "==", "<", "<<", "+", "-", "*"};
+    std::uniform_int_distribution<int> op(0, 10);
+    std::uniform_int_distribution<int> number(0, 99999);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (int i = 0; i < count; i++) {
+        if (i > 0) {
+            str += ops[op(gen)];
+        }
+        if (percent(gen) < 10) {
+            str += '-';
+        }
+        if (count > 8 && percent(gen) < 5) {
+            str += '(';
+            append_expression(str, gen, 8);
+            str += ')';
+        } else {
+            str += std::to_string(number(gen));
+        }
+    }
+}
+
+std::string make_input(int count) {
+    std::mt19937 gen(42);
+    std::string str;
+    append_expression(str, gen, count);
+    return str;
+}
+
+void BM_expression(benchmark::State& state, auto const& parser) {
+    std::string input = make_input(state.range(0));
+    // Both parsers must agree on the value
+    auto expected = tower.parse(input);
+    for (auto _ : state) {
+        auto result = parser.parse(input);
+        if (!result || !result.get_state().empty()
+            || result.get_value() != expected.get_value()) {
+            throw std::runtime_error("Parse failed");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+void BM_expression_fold_left(benchmark::State& state) {
+    BM_expression(state, tower);
+}
+void BM_expression_pratt(benchmark::State& state) {
+    BM_expression(state, pratt);
+}
+
+BENCHMARK(BM_expression_fold_left)->Arg(100000);
+BENCHMARK(BM_expression_pratt)->Arg(100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,179 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <noam/combinators.hpp>
+#include <noam/intrinsics.hpp>
+#include <noam/mapped_file.hpp>
+#include <noam/stream.hpp>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+
+constexpr noam::parser sum_ints = noam::fold_left(
+    noam::parse_long,
+    noam::comma_separator >> noam::parse_long,
+    [](long sum, long value) { return sum + value; });
+
+/**
+ * @brief A generated file, made by repeating a 1 MiB block of records. The
+ * size of the file (in bytes) can be set with the NOAM_BENCH_FILE_SIZE
+ * environment variable, and defaults to 2 GiB. The file is only regenerated
+ * if its size changes.
+ *
+ */
+struct generated_file {
+    fs::path path;
+    long expected_sum = 0;
+
+    /**
+     * @param name the name of the file within the temporary directory
+     * @param separator written after each value in the block
+     * @param last written at the end of the file
+     */
+    generated_file(char const* name, std::string_view separator, char last) {
+        size_t target_size = size_t(2) << 30;
+        if (char const* size = std::getenv("NOAM_BENCH_FILE_SIZE")) {
+            target_size = std::stoull(size);
+        }
+        path = fs::temp_directory_path() / name;
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dist(0, 32767);
+        std::string block;
+        long block_sum = 0;
+        while (block.size() < (1 << 20)) {
+            int value = dist(gen);
+            block_sum += value;
+            block += std::to_string(value);
+            block += separator;
+        }
+        size_t blocks = std::max<size_t>(target_size / block.size(), 1);
+        size_t file_size = blocks * block.size() + 1;
+        expected_sum = block_sum * long(blocks);
+
+        std::error_code ec;
+        if (fs::file_size(path, ec) != file_size || ec) {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            for (size_t i = 0; i < blocks; i++) {
+                file.write(block.data(), block.size());
+            }
+            file.write(&last, 1);
+        }
+    }
+
+    void validate(auto result) const {
+        if (!result) {
+            throw std::runtime_error("Parse failed");
+        }
+        if (result.get_value() != expected_sum) {
+            throw std::runtime_error("Recieved bad value");
+        }
+        if (!result.get_state().empty()) {
+            throw std::runtime_error("Failed to read entire file");
+        }
+    }
+    void validate_sum(long sum) const {
+        if (sum != expected_sum) {
+            throw std::runtime_error("Recieved bad value");
+        }
+    }
+    size_t size() const { return fs::file_size(path); }
+};
+
+/**
+ * @brief A file of comma-separated ints. It ends in a value so that it
+ * doesn't end with a separator.
+ */
+generated_file const& get_int_file() {
+    static generated_file file("noam-bench-ints.csv", ", ", '0');
+    return file;
+}
+
+/**
+ * @brief A file with one int per line, like a log
+ */
+generated_file const& get_line_file() {
+    static generated_file file("noam-bench-lines.txt", "\n", '\n');
+    return file;
+}
+
+void BM_parse_mapped_file(benchmark::State& state) {
+    auto& input = get_int_file();
+    for (auto _ : state) {
+        noam::mapped_file file(input.path);
+        input.validate(sum_ints.parse(file));
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+void BM_parse_read_into_string(benchmark::State& state) {
+    auto& input = get_int_file();
+    for (auto _ : state) {
+        std::ifstream file(input.path, std::ios::binary);
+        std::string contents(input.size(), '\0');
+        file.read(contents.data(), contents.size());
+        input.validate(sum_ints.parse(contents));
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+/**
+ * @brief Parses each line of a file with parse_line, streaming it through a
+ * fixed-size buffer
+ */
+void BM_stream_lines(benchmark::State& state) {
+    auto& input = get_line_file();
+    for (auto _ : state) {
+        std::ifstream file(input.path, std::ios::binary);
+        long sum = 0;
+        auto result = noam::for_each_record(
+            file,
+            noam::parse_line,
+            [&](std::string_view line) {
+                sum += noam::parse_long.parse(line).get_value();
+            },
+            state.range(0));
+        if (!result) {
+            throw std::runtime_error("Parse failed");
+        }
+        input.validate_sum(sum);
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+/**
+ * @brief Parses each line of a mapped file with parse_line
+ */
+void BM_mapped_lines(benchmark::State& state) {
+    auto& input = get_line_file();
+    for (auto _ : state) {
+        noam::mapped_file file(input.path);
+        noam::state_t st = file;
+        long sum = 0;
+        while (!st.empty()) {
+            auto line = noam::parse_line.parse(st);
+            sum += noam::parse_long.parse(line.get_value()).get_value();
+            st = line.get_state();
+        }
+        input.validate_sum(sum);
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+BENCHMARK(BM_parse_mapped_file)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK(BM_parse_read_into_string)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(3);
+
+BENCHMARK(BM_stream_lines)
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(3)
+    ->Arg(1 << 12)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
+BENCHMARK(BM_mapped_lines)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+BENCHMARK_MAIN();
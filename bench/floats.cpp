@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <noam/intrinsics.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Comma-separated random numbers, formatted with the given printf
+ * format. Each number is between -1 and 1, scaled by 10^(random exponent in
+ * [min_exp, max_exp]).
+ */
+std::string make_floats(char const* format, int min_exp, int max_exp) {
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> mantissa(-1, 1);
+    std::uniform_int_distribution<int> exponent(min_exp, max_exp);
+    std::string str;
+    char buffer[64];
+    for (int i = 0; i < 1000; i++) {
+        double value = mantissa(gen) * std::pow(10.0, exponent(gen));
+        int size = std::snprintf(buffer, sizeof(buffer), format, value);
+        str.append(buffer, size);
+        str += ',';
+    }
+    return str;
+}
+
+// Prices and measurements: "-12.34"
+std::string short_floats() { return make_floats("%.2f", 0, 3); }
+// Full precision, as printed by a serializer: "0.12345678901234566"
+std::string long_floats() { return make_floats("%.17g", -2, 2); }
+// Scientific notation, over a wide range: "-6.022e+23"
+std::string scientific_floats() { return make_floats("%.4e", -300, 300); }
+
+/**
+ * @brief Parses every number in the input with the given function, which
+ * returns the remaining input. Reports the number of floats parsed.
+ */
+void BM_parse_floats(
+    benchmark::State& state,
+    auto make_input,
+    auto parse_one) {
+    std::string input = make_input();
+    for (auto _ : state) {
+        noam::state_t st = input;
+        while (!st.empty()) {
+            st = parse_one(st);
+            st.remove_prefix(1);
+        }
+        benchmark::DoNotOptimize(st);
+    }
+    state.SetItemsProcessed(1000 * state.iterations());
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+template <auto& parser>
+noam::state_t parse_with(noam::state_t st) {
+    auto result = parser.parse(st);
+    if (!result) {
+        throw std::runtime_error("Parse failed");
+    }
+    benchmark::DoNotOptimize(result.get_value());
+    return result.get_state();
+}
+
+noam::state_t parse_with_from_chars(noam::state_t st) {
+    double value;
+    auto result = std::from_chars(st.begin(), st.end(), value);
+    benchmark::DoNotOptimize(value);
+    return {result.ptr, st.end()};
+}
+
+#if NOAM_USE_FAST_FLOAT
+noam::state_t parse_with_fast_float(noam::state_t st) {
+    double value;
+    auto result = fast_float::from_chars(st.begin(), st.end(), value);
+    benchmark::DoNotOptimize(value);
+    return {result.ptr, st.end()};
+}
+#endif
+
+// strtod stops at the ',' after each number, since the input isn't null
+// terminated until the end
+noam::state_t parse_with_strtod(noam::state_t st) {
+    char* end;
+    double value = std::strtod(st.begin(), &end);
+    benchmark::DoNotOptimize(value);
+    return {end, st.end()};
+}
+
+#define FLOAT_BENCHMARKS(input)                                                \
+    BENCHMARK_CAPTURE(                                                         \
+        BM_parse_floats,                                                       \
+        input##_from_chars,                                                    \
+        input,                                                                 \
+        parse_with_from_chars);                                                \
+    BENCHMARK_CAPTURE(                                                         \
+        BM_parse_floats,                                                       \
+        input##_strtod,                                                        \
+        input,                                                                 \
+        parse_with_strtod);                                                    \
+    BENCHMARK_CAPTURE(                                                         \
+        BM_parse_floats,                                                       \
+        input##_parse_double,                                                  \
+        input,                                                                 \
+        parse_with<noam::parse_double>);                                       \
+    BENCHMARK_CAPTURE(                                                         \
+        BM_parse_floats,                                                       \
+        input##_parse_json_double,                                             \
+        input,                                                                 \
+        parse_with<noam::parse_json_double>);                                  \
+    BENCHMARK_CAPTURE(                                                         \
+        BM_parse_floats,                                                       \
+        input##_parse_long_double,                                             \
+        input,                                                                 \
+        parse_with<noam::parse_long_double>)
+
+FLOAT_BENCHMARKS(short_floats);
+FLOAT_BENCHMARKS(long_floats);
+FLOAT_BENCHMARKS(scientific_floats);
+
+#if NOAM_USE_FAST_FLOAT
+BENCHMARK_CAPTURE(
+    BM_parse_floats,
+    short_floats_fast_float,
+    short_floats,
+    parse_with_fast_float);
+BENCHMARK_CAPTURE(
+    BM_parse_floats,
+    long_floats_fast_float,
+    long_floats,
+    parse_with_fast_float);
+BENCHMARK_CAPTURE(
+    BM_parse_floats,
+    scientific_floats_fast_float,
+    scientific_floats,
+    parse_with_fast_float);
+#endif
+
+BENCHMARK_MAIN();
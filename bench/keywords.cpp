@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include <noam/intrinsics.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// Literals are tried in order, so keywords come before any keyword which is
+// a prefix of them ("ASC" before "AS")
+#define SQL_KEYWORDS                                                           \
+    "SELECT", "FROM", "WHERE", "INSERT", "INTO", "VALUES", "UPDATE", "SET",    \
+        "DELETE", "CREATE", "TABLE", "DROP", "ALTER", "ADD", "COLUMN",         \
+        "INDEX", "VIEW", "JOIN", "INNER", "LEFT", "RIGHT", "OUTER", "FULL",    \
+        "CROSS", "ON", "USING", "GROUP", "BY", "ORDER", "HAVING", "LIMIT",     \
+        "OFFSET", "UNION", "ALL", "DISTINCT", "ASC", "AND", "OR", "NOT",       \
+        "NULL", "IS", "IN", "BETWEEN", "LIKE", "EXISTS", "CASE", "WHEN",       \
+        "THEN", "ELSE", "END", "PRIMARY", "KEY", "FOREIGN", "REFERENCES",      \
+        "DEFAULT", "CHECK", "UNIQUE", "CONSTRAINT", "AS", "DESC", "BEGIN",     \
+        "COMMIT", "ROLLBACK", "TRANSACTION"
+
+constexpr std::string_view keywords[] {SQL_KEYWORDS};
+static_assert(std::size(keywords) == 64);
+
+/**
+ * @brief Tries each literal in turn, which is how literal<...> matched
+ * before it used a trie
+ */
+template <noam::any_literal... Literals>
+struct literal_fold {
+    constexpr auto parse(noam::state_t st) const -> noam::result<noam::empty> {
+        if ((Literals.check_and_update(st) || ...)) {
+            return {st, noam::empty {}};
+        } else {
+            return {};
+        }
+    }
+};
+
+/**
+ * @brief Space-separated random keywords. Later keywords in the list are
+ * as likely as earlier ones.
+ */
+std::string make_keywords() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> keyword(0, std::size(keywords) - 1);
+    std::string str;
+    for (int i = 0; i < 1000; i++) {
+        str += keywords[keyword(gen)];
+        str += ' ';
+    }
+    return str;
+}
+
+void BM_keywords(benchmark::State& state, auto parser) {
+    std::string input = make_keywords();
+    for (auto _ : state) {
+        noam::state_t st = input;
+        while (!st.empty()) {
+            auto result = parser.parse(st);
+            if (!result) {
+                throw std::runtime_error("Parse failed");
+            }
+            st = result.get_state();
+            st.remove_prefix(1);
+        }
+        benchmark::DoNotOptimize(st);
+    }
+    state.SetItemsProcessed(1000 * state.iterations());
+}
+
+BENCHMARK_CAPTURE(
+    BM_keywords,
+    fold,
+    noam::parser {literal_fold<SQL_KEYWORDS> {}});
+BENCHMARK_CAPTURE(BM_keywords, trie, noam::literal<SQL_KEYWORDS>);
+
+/**
+ * @brief Matches "true", "false" or "null", comparing the bytes one at a time,
+ * which is how string_literal matched before it compared whole words
+ */
+bool match_value_bytewise(noam::state_t& st) {
+    for (std::string_view value : {"true", "false", "null"}) {
+        if (st.starts_with(value)) {
+            st.remove_prefix(value.size());
+            return true;
+        }
+    }
+    return false;
+}
+
+bool match_value_word(noam::state_t& st) {
+    return noam::check_any_and_update<"true", "false", "null">(st);
+}
+
+/**
+ * @brief JSON-like values ("true", "false" and "null"), space separated
+ */
+std::string make_values() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> value(0, 2);
+    constexpr std::string_view values[] {"true", "false", "null"};
+    std::string str;
+    for (int i = 0; i < 1000; i++) {
+        str += values[value(gen)];
+        str += ' ';
+    }
+    return str;
+}
+
+void BM_values(benchmark::State& state, auto match) {
+    std::string input = make_values();
+    for (auto _ : state) {
+        noam::state_t st = input;
+        while (!st.empty()) {
+            if (!match(st)) {
+                throw std::runtime_error("Parse failed");
+            }
+            st.remove_prefix(1);
+        }
+        benchmark::DoNotOptimize(st);
+    }
+    state.SetItemsProcessed(1000 * state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_values, bytewise, match_value_bytewise);
+BENCHMARK_CAPTURE(BM_values, word, match_value_word);
+
+BENCHMARK_MAIN();
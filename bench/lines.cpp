@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <noam/intrinsics.hpp>
+#include <noam/split_lines.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Log-like input: lines with an average length given by the
+ * benchmark's argument, some of which end in "\r\n"
+ */
+std::string make_log(size_t average_length) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> length(0, average_length * 2);
+    std::bernoulli_distribution crlf(0.25);
+    std::string log;
+    while (log.size() < (1 << 20)) {
+        log.append(length(gen), 'x');
+        log += crlf(gen) ? "\r\n" : "\n";
+    }
+    return log;
+}
+
+void BM_parse_line_loop(benchmark::State& state) {
+    std::string log = make_log(state.range(0));
+    for (auto _ : state) {
+        noam::state_t st = log;
+        size_t count = 0;
+        while (!st.empty()) {
+            auto line = noam::parse_line.parse(st);
+            benchmark::DoNotOptimize(line.get_value());
+            st = line.get_state();
+            count++;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(log.size() * state.iterations());
+}
+
+void BM_split_lines_vector(benchmark::State& state) {
+    std::string log = make_log(state.range(0));
+    std::vector<std::string_view> lines;
+    for (auto _ : state) {
+        lines.clear();
+        noam::split_lines(log, lines);
+        benchmark::DoNotOptimize(lines.data());
+    }
+    state.SetBytesProcessed(log.size() * state.iterations());
+}
+
+void BM_split_lines_span(benchmark::State& state) {
+    std::string log = make_log(state.range(0));
+    std::vector<std::string_view> batch(256);
+    for (auto _ : state) {
+        noam::state_t st = log;
+        while (!st.empty()) {
+            auto result = noam::split_lines(st, std::span(batch));
+            benchmark::DoNotOptimize(batch.data());
+            st = result.get_state();
+        }
+    }
+    state.SetBytesProcessed(log.size() * state.iterations());
+}
+
+BENCHMARK(BM_parse_line_loop)->Arg(16)->Arg(80)->Arg(400);
+BENCHMARK(BM_split_lines_vector)->Arg(16)->Arg(80)->Arg(400);
+BENCHMARK(BM_split_lines_span)->Arg(16)->Arg(80)->Arg(400);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <noam/combinators.hpp>
+#include <noam/flat_map.hpp>
+#include <noam/intrinsics.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief Objects with `keys` keys each, such as {"field_0012": 731, ...},
+ * separated by spaces. Keys are shuffled, so they aren't already sorted.
+ * There are enough objects for 16384 keys in total.
+ */
+std::string make_objects(size_t keys) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> value(0, 99999);
+    std::vector<int> ids(keys);
+    std::string str;
+    for (size_t objects = 16384 / keys; objects > 0; objects--) {
+        for (size_t i = 0; i < keys; i++) {
+            ids[i] = int(i);
+        }
+        std::shuffle(ids.begin(), ids.end(), gen);
+        str += '{';
+        for (size_t i = 0; i < keys; i++) {
+            std::string id = std::to_string(ids[i]);
+            str += "\"field_" + std::string(4 - id.size(), '0') + id + "\": ";
+            str += std::to_string(value(gen));
+            str += i + 1 < keys ? ", " : "} ";
+        }
+    }
+    return str;
+}
+
+void BM_objects(benchmark::State& state, auto const& parser) {
+    size_t keys = state.range(0);
+    std::string input = make_objects(keys);
+    for (auto _ : state) {
+        noam::state_t st = input;
+        while (!st.empty()) {
+            auto result = parser.parse(st);
+            if (!result || result.get_value().size() != keys) {
+                throw std::runtime_error("Parse failed");
+            }
+            benchmark::DoNotOptimize(result);
+            st = result.get_state();
+            st.remove_prefix(1);
+        }
+    }
+    state.SetItemsProcessed(16384 * state.iterations());
+}
+
+template <class Map>
+constexpr auto parse_object = noam::parse_map<Map>(
+    noam::parse_string_view,
+    noam::parse_int);
+template <class Map>
+constexpr auto parse_object_bulk = noam::parse_map_bulk<Map>(
+    noam::parse_string_view,
+    noam::parse_int);
+
+using tree = std::map<std::string_view, int>;
+using hash = std::unordered_map<std::string_view, int>;
+using flat = noam::flat_map<std::string_view, int>;
+
+void BM_map(benchmark::State& state) {
+    BM_objects(state, parse_object<tree>);
+}
+void BM_map_bulk(benchmark::State& state) {
+    BM_objects(state, parse_object_bulk<tree>);
+}
+void BM_unordered_map(benchmark::State& state) {
+    BM_objects(state, parse_object<hash>);
+}
+void BM_unordered_map_bulk(benchmark::State& state) {
+    BM_objects(state, parse_object_bulk<hash>);
+}
+void BM_flat_map_bulk(benchmark::State& state) {
+    BM_objects(state, parse_object_bulk<flat>);
+}
+
+BENCHMARK(BM_map)->Arg(4)->Arg(64)->Arg(4096);
+BENCHMARK(BM_map_bulk)->Arg(4)->Arg(64)->Arg(4096);
+BENCHMARK(BM_unordered_map)->Arg(4)->Arg(64)->Arg(4096);
+BENCHMARK(BM_unordered_map_bulk)->Arg(4)->Arg(64)->Arg(4096);
+BENCHMARK(BM_flat_map_bulk)->Arg(4)->Arg(64)->Arg(4096);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <noam/combinators.hpp>
+#include <noam/memo.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+constexpr noam::parser open = noam::literal<'('>;
+constexpr auto plus_one = [](int depth) { return depth + 1; };
+
+/**
+ * @brief Parses "a", "(a)", "((a))!", and so on. Both alternatives parse the
+ * nested value before they can fail, so a failed first alternative parses it
+ * again: without memoization, the number of parses doubles with each level.
+ */
+template <class Wrap>
+constexpr auto nested_grammar(Wrap wrap) {
+    return noam::recurse<int>([=](auto self) {
+        return wrap(noam::either(
+            noam::map(plus_one, noam::enclose(open, self, noam::literal<")!">)),
+            noam::map(plus_one, noam::enclose(open, self, noam::literal<')'>)),
+            noam::literal_constant<0, 'a'>));
+    });
+}
+
+constexpr noam::parser nested = nested_grammar([](auto p) { return p; });
+constexpr noam::parser nested_memo =
+    nested_grammar([](auto p) { return noam::memo(p); });
+
+std::string make_input(int depth) {
+    return std::string(depth, '(') + "a" + std::string(depth, ')');
+}
+
+void BM_nested(benchmark::State& state, auto const& parser, bool use_memo) {
+    int depth = state.range(0);
+    std::string input = make_input(depth);
+    for (auto _ : state) {
+        // A table is only valid for one parse of one input
+        std::optional<noam::memo_table> memo;
+        if (use_memo) {
+            memo.emplace();
+        }
+        auto result = parser.parse(input);
+        if (!result.check_value(depth)) {
+            throw std::runtime_error("Parse failed");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+void BM_nested_plain(benchmark::State& state) {
+    BM_nested(state, nested, false);
+}
+void BM_nested_memo(benchmark::State& state) {
+    BM_nested(state, nested_memo, true);
+}
+
+BENCHMARK(BM_nested_plain)->DenseRange(4, 16, 4);
+BENCHMARK(BM_nested_memo)->DenseRange(4, 16, 4)->Arg(256)->Arg(4096);
+
+BENCHMARK_MAIN();
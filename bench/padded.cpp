@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <noam/intrinsics.hpp>
+#include <noam/padded.hpp>
+#include <random>
+#include <string>
+
+/**
+ * @brief Lines of random length, each indented by a random amount
+ */
+std::string const& get_indented_lines() {
+    static std::string const lines = [] {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> indent(0, 64);
+        std::uniform_int_distribution<int> length(0, 120);
+        std::string result;
+        while (result.size() < (1 << 20)) {
+            result.append(indent(gen), ' ');
+            result.append(length(gen), 'x');
+            result += '\n';
+        }
+        return result;
+    }();
+    return lines;
+}
+
+/**
+ * @brief Skips the indentation of each line, then reads the rest of the line
+ */
+template <class State>
+size_t count_indentation(State st) {
+    size_t total = 0;
+    while (!st.empty()) {
+        auto indent = noam::count_spaces.parse(st);
+        total += indent.get_value();
+        st = State(indent.get_state().begin(), indent.get_state().end());
+        auto line = noam::parse_line.parse(st);
+        st = State(line.get_state().begin(), line.get_state().end());
+    }
+    return total;
+}
+
+void BM_lines_unpadded(benchmark::State& state) {
+    std::string const& input = get_indented_lines();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(count_indentation(noam::state_t(input)));
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+void BM_lines_padded(benchmark::State& state) {
+    noam::padded_buffer input(get_indented_lines());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(count_indentation(input.state()));
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+BENCHMARK(BM_lines_unpadded);
+BENCHMARK(BM_lines_padded);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <noam/combinators.hpp>
+#include <noam/intrinsics.hpp>
+#include <noam/push_parser.hpp>
+#include <random>
+#include <string_view>
+#include <vector>
+
+// The document from src/json-example.cpp
+constexpr std::string_view json_example = R"({
+    "glossary": {
+        "foo": null,
+        "title": "example glossary",
+		"GlossDiv": {
+            "title": "S",
+			"GlossList": {
+                "GlossEntry": {
+                    "ID": "SGML",
+					"SortAs": "SGML",
+					"GlossTerm": "Standard Generalized Markup Language",
+					"Acronym": "SGML",
+					"Abbrev": "ISO 8879:1986",
+					"GlossDef": {
+                        "para": "A meta-markup language, used to create markup languages such as DocBook.",
+						"GlossSeeAlso": ["GML", "XML", 10, 20, 30, 40, null, [1, 2, 3, 4, "hello", {"blarg": [[], [], [[], [[[], ["blarg", {"foo": [10, 20, 10, 1]}]], 20]]]}]]
+                    },
+					"GlossSee": "markup"
+                }
+            }
+        }
+    }
+})";
+
+constexpr auto as_empty = [](auto&&) { return noam::empty {}; };
+
+/**
+ * @brief Parses one JSON token: a structural character, a literal, a string,
+ * or a number
+ *
+ */
+constexpr noam::parser json_token = noam::either(
+    noam::literal<'{', '}', '[', ']', ':', ','>,
+    noam::literal<"true", "false", "null">,
+    noam::map(as_empty, noam::parse_string_view),
+    noam::map(as_empty, noam::parse_double));
+
+/**
+ * @brief Counts the tokens in a JSON document, as input arrives
+ */
+noam::push_parser<size_t> count_json_tokens() {
+    size_t count = 0;
+    noam::parser next_token = noam::try_parse(json_token);
+    co_await noam::whitespace;
+    while (co_await next_token) {
+        count++;
+        co_await noam::whitespace;
+    }
+    co_return count;
+}
+
+/**
+ * @brief Splits the input into fragments with sizes picked uniformly at
+ * random from [1, max_size]
+ */
+std::vector<std::string_view> make_fragments(
+    std::string_view input,
+    size_t max_size) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> dist(1, max_size);
+    std::vector<std::string_view> fragments;
+    while (!input.empty()) {
+        size_t size = std::min(dist(gen), input.size());
+        fragments.push_back(input.substr(0, size));
+        input.remove_prefix(size);
+    }
+    return fragments;
+}
+
+size_t count_tokens_at_once(std::string_view input) {
+    auto parser = count_json_tokens();
+    parser.feed(input);
+    parser.finish();
+    return parser.get_value();
+}
+
+void BM_push_json(benchmark::State& state) {
+    auto fragments = make_fragments(json_example, state.range(0));
+    size_t expected = count_tokens_at_once(json_example);
+    for (auto _ : state) {
+        auto parser = count_json_tokens();
+        for (std::string_view fragment : fragments) {
+            parser.feed(fragment);
+        }
+        if (parser.finish() != noam::push_status::done) {
+            throw std::runtime_error("Parse failed");
+        }
+        if (parser.get_value() != expected) {
+            throw std::runtime_error("Fragmented parse produced bad value");
+        }
+    }
+    state.SetBytesProcessed(json_example.size() * state.iterations());
+}
+
+BENCHMARK(BM_push_json)->Arg(1)->Arg(16)->Arg(256)->Arg(4096);
+
+BENCHMARK_MAIN();
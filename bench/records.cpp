@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <noam/combinators.hpp>
+#include <noam/intrinsics.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief `count` records of `arity` comma-separated numbers, one per line,
+ * such as "12, 200, 7"
+ */
+std::string make_records(size_t count, size_t arity) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> value(0, 255);
+    std::string str;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < arity; j++) {
+            str += std::to_string(value(gen));
+            str += j + 1 < arity ? ", " : "\n";
+        }
+    }
+    return str;
+}
+
+/**
+ * @brief Parses each record in turn, summing the first value of each
+ */
+void BM_records(benchmark::State& state, size_t arity, auto const& parser) {
+    constexpr size_t count = 10000;
+    std::string input = make_records(count, arity);
+    for (auto _ : state) {
+        noam::state_t st = input;
+        long total = 0;
+        while (!st.empty()) {
+            auto result = parser.parse(st);
+            if (!result || result.get_value().size() != arity) {
+                throw std::runtime_error("Parse failed");
+            }
+            total += result.get_value()[0];
+            st = result.get_state();
+            st.remove_prefix(1);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(count * state.iterations());
+}
+
+void BM_rgb_sequence(benchmark::State& state) {
+    BM_records(state, 3, noam::sequence(noam::parse_int));
+}
+void BM_rgb_repeat(benchmark::State& state) {
+    BM_records(
+        state,
+        3,
+        noam::repeat<3>(noam::parse_int, noam::comma_separator));
+}
+void BM_rgb_repeat_bounded(benchmark::State& state) {
+    BM_records(
+        state,
+        3,
+        noam::repeat<1, 4>(noam::parse_int, noam::comma_separator));
+}
+void BM_matrix_sequence(benchmark::State& state) {
+    BM_records(state, 16, noam::sequence(noam::parse_int));
+}
+void BM_matrix_repeat(benchmark::State& state) {
+    BM_records(
+        state,
+        16,
+        noam::repeat<16>(noam::parse_int, noam::comma_separator));
+}
+
+BENCHMARK(BM_rgb_sequence);
+BENCHMARK(BM_rgb_repeat);
+BENCHMARK(BM_rgb_repeat_bounded);
+BENCHMARK(BM_matrix_sequence);
+BENCHMARK(BM_matrix_repeat);
+
+BENCHMARK_MAIN();
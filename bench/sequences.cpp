@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+
+#include <memory_resource>
+#include <noam/combinators.hpp>
+#include <noam/intrinsics.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 10000 short bracketed lists of 1 to 6 integers, such as
+ * "[12, 7, 301]", each followed by a space
+ */
+std::string make_short_lists() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> length(1, 6);
+    std::uniform_int_distribution<int> value(0, 9999);
+    std::string str;
+    for (int i = 0; i < 10000; i++) {
+        str += '[';
+        for (int n = length(gen); n > 0; n--) {
+            str += std::to_string(value(gen));
+            str += n > 1 ? ", " : "] ";
+        }
+    }
+    return str;
+}
+
+/**
+ * @brief One list of `count` integers, without brackets
+ */
+std::string make_long_list(size_t count) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> value(0, 999999);
+    std::string str;
+    for (size_t i = 0; i < count; i++) {
+        str += std::to_string(value(gen));
+        str += ", ";
+    }
+    str.resize(str.size() - 2);
+    return str;
+}
+
+// sequence_into gives the number of values, and other parsers the values
+size_t count(size_t values) { return values; }
+size_t count(auto const& values) { return values.size(); }
+
+/**
+ * @brief Parses each list in turn, summing the sizes of the values produced
+ */
+size_t parse_lists(auto const& parser, noam::state_t st) {
+    size_t total = 0;
+    while (!st.empty()) {
+        auto result = parser.parse(st);
+        if (!result) {
+            throw std::runtime_error("Parse failed");
+        }
+        total += count(result.get_value());
+        st = result.get_state();
+        st.remove_prefix(1);
+    }
+    return total;
+}
+
+void BM_short_lists_vector(benchmark::State& state) {
+    std::string input = make_short_lists();
+    constexpr auto list = noam::sequence<'[', ',', ']'>(noam::parse_int);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parse_lists(list, input));
+    }
+    state.SetItemsProcessed(10000 * state.iterations());
+}
+void BM_short_lists_arena(benchmark::State& state) {
+    std::string input = make_short_lists();
+    std::pmr::monotonic_buffer_resource arena;
+    auto list = noam::sequence_as<std::pmr::vector<int>, '[', ',', ']'>(
+        noam::parse_int,
+        &arena);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parse_lists(list, input));
+        arena.release();
+    }
+    state.SetItemsProcessed(10000 * state.iterations());
+}
+void BM_short_lists_into(benchmark::State& state) {
+    std::string input = make_short_lists();
+    std::vector<int> values;
+    auto list = noam::sequence_into<'[', ',', ']'>(values, noam::parse_int);
+    for (auto _ : state) {
+        values.clear();
+        benchmark::DoNotOptimize(parse_lists(list, input));
+    }
+    state.SetItemsProcessed(10000 * state.iterations());
+}
+
+void BM_long_list(benchmark::State& state, auto const& parser) {
+    std::string input = make_long_list(state.range(0));
+    for (auto _ : state) {
+        auto result = parser.parse(input);
+        if (result.get_value().size() != size_t(state.range(0))) {
+            throw std::runtime_error("Parse failed");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+void BM_long_list_vector(benchmark::State& state) {
+    BM_long_list(state, noam::sequence(noam::parse_int));
+}
+void BM_long_list_exact(benchmark::State& state) {
+    BM_long_list(state, noam::sequence_exact(noam::parse_int));
+}
+
+BENCHMARK(BM_short_lists_vector);
+BENCHMARK(BM_short_lists_arena);
+BENCHMARK(BM_short_lists_into);
+BENCHMARK(BM_long_list_vector)->Arg(1000)->Arg(1000000);
+BENCHMARK(BM_long_list_exact)->Arg(1000)->Arg(1000000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <noam/state.hpp>
+#include <string>
+
+/**
+ * @brief Two keys of the given length which differ only in their last byte,
+ * so that a comparison has to examine every byte
+ */
+struct key_pair {
+    std::string a;
+    std::string b;
+    key_pair(size_t length)
+      : a(length, 'k')
+      , b(length, 'k') {
+        b.back() = 'l';
+    }
+};
+
+/**
+ * @brief The byte-at-a-time comparison used at compile time, as a baseline
+ */
+bool bytewise_equal(noam::state_t a, noam::state_t b) {
+    if (a.size() != b.size())
+        return false;
+    for (intptr_t i = 0; i < a.size(); i++) {
+        if (a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+void BM_state_equal(benchmark::State& state) {
+    key_pair keys(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(keys.a);
+        benchmark::DoNotOptimize(keys.b);
+        bool equal = noam::state_t(keys.a) == noam::state_t(keys.b);
+        benchmark::DoNotOptimize(equal);
+    }
+    state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+
+void BM_state_equal_bytewise(benchmark::State& state) {
+    key_pair keys(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(keys.a);
+        benchmark::DoNotOptimize(keys.b);
+        bool equal = bytewise_equal(keys.a, keys.b);
+        benchmark::DoNotOptimize(equal);
+    }
+    state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+
+void BM_state_starts_with(benchmark::State& state) {
+    key_pair keys(state.range(0));
+    std::string input = keys.a + " and some more input";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(input);
+        benchmark::DoNotOptimize(keys.a);
+        bool match = noam::state_t(input).starts_with(keys.a);
+        benchmark::DoNotOptimize(match);
+    }
+    state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+
+void BM_state_compare(benchmark::State& state) {
+    key_pair keys(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(keys.a);
+        benchmark::DoNotOptimize(keys.b);
+        bool less = noam::state_t(keys.a) < noam::state_t(keys.b);
+        benchmark::DoNotOptimize(less);
+    }
+    state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+
+BENCHMARK(BM_state_equal)->RangeMultiplier(2)->Range(1, 256);
+BENCHMARK(BM_state_equal_bytewise)->RangeMultiplier(2)->Range(1, 256);
+BENCHMARK(BM_state_starts_with)->RangeMultiplier(2)->Range(1, 256);
+BENCHMARK(BM_state_compare)->RangeMultiplier(2)->Range(1, 256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <noam/intrinsics.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief A quoted JSON-style string whose contents have the given length.
+ * `escape_percent` of the characters are escape sequences.
+ */
+std::string make_quoted_string(size_t length, int escape_percent) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::string escapes[] {
+        "\\n",
+        "\\t",
+        "\\\"",
+        "\\\\",
+        "\\/",
+        "\\u00e9",
+        "\\ud83d\\ude00"};
+    std::uniform_int_distribution<int> escape(0, 6);
+    std::string str = "\"";
+    while (str.size() < length + 1) {
+        if (percent(gen) < escape_percent) {
+            str += escapes[escape(gen)];
+        } else {
+            str += char(letter(gen));
+        }
+    }
+    str += "\"";
+    return str;
+}
+
+void BM_parse_string_view(benchmark::State& state) {
+    std::string input = make_quoted_string(state.range(0), state.range(1));
+    for (auto _ : state) {
+        auto result = noam::parse_string_view.parse(input);
+        if (!result || !result.get_state().empty()) {
+            throw std::runtime_error("Parse failed");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+void BM_parse_string(benchmark::State& state) {
+    std::string input = make_quoted_string(state.range(0), state.range(1));
+    for (auto _ : state) {
+        auto result = noam::parse_string.parse(input);
+        if (!result || !result.get_state().empty()) {
+            throw std::runtime_error("Parse failed");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+void BM_parse_string_cow(benchmark::State& state) {
+    std::string input = make_quoted_string(state.range(0), state.range(1));
+    for (auto _ : state) {
+        auto result = noam::parse_string_cow.parse(input);
+        if (!result || !result.get_state().empty()) {
+            throw std::runtime_error("Parse failed");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+void BM_parse_string_insitu(benchmark::State& state) {
+    std::string const input = make_quoted_string(
+        state.range(0),
+        state.range(1));
+    std::string buffer;
+    for (auto _ : state) {
+        // The buffer is overwritten by each parse, so it's restored first
+        buffer.assign(input);
+        auto result = noam::parse_string_insitu(buffer).parse(buffer);
+        if (!result || !result.get_state().empty()) {
+            throw std::runtime_error("Parse failed");
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(input.size() * state.iterations());
+}
+
+BENCHMARK(BM_parse_string_view)
+    ->ArgNames({"length", "escape_percent"})
+    ->ArgsProduct({{16, 256, 4096}, {0, 1, 10}});
+
+BENCHMARK(BM_parse_string)
+    ->ArgNames({"length", "escape_percent"})
+    ->ArgsProduct({{16, 256, 4096}, {0, 1, 10}});
+
+BENCHMARK(BM_parse_string_cow)
+    ->ArgNames({"length", "escape_percent"})
+    ->ArgsProduct({{16, 256, 4096}, {0, 1, 10}});
+BENCHMARK(BM_parse_string_insitu)
+    ->ArgNames({"length", "escape_percent"})
+    ->ArgsProduct({{16, 256, 4096}, {0, 1, 10}});
+
+BENCHMARK_MAIN();
@@ -1,10 +1,14 @@
 #pragma once
+#include <iterator>
+#include <noam/flat_map.hpp>
 #include <noam/intrinsics.hpp>
 #include <noam/operators.hpp>
 #include <noam/parser.hpp>
 #include <noam/result_types.hpp>
 #include <noam/type_traits.hpp>
 #include <noam/util/combinator_types.hpp>
+#include <noam/util/partial_input.hpp>
+#include <utility>
 #include <vector>
 
 namespace noam {
@@ -49,6 +53,103 @@ constexpr auto fold_left(Parser1&& initial, Parser2&& rest, Op&& op) {
     } / make_parser;
 }
 
+/**
+ * @brief A prefix operator for an operator_table, such as unary minus. Its
+ * operand is an expression whose operators bind at least as tightly as
+ * `Power`.
+ *
+ * @tparam Symbol the literal which starts the operator
+ * @tparam Power the binding power of the operator
+ * @param func takes the operand and returns the result
+ */
+template <any_literal Symbol, int Power, class Func>
+constexpr auto prefix_op(Func&& func) {
+    return parsers::operator_def<
+        parsers::operator_kind::prefix,
+        Symbol,
+        Power,
+        assoc::right,
+        std::decay_t<Func>> {std::forward<Func>(func)};
+}
+/**
+ * @brief An infix operator for an operator_table, such as `+` or `*`
+ *
+ * @tparam Symbol the literal between the operands
+ * @tparam Power the binding power of the operator
+ * @tparam Associativity how a chain of operators with the same power groups
+ * @param func takes the left and right operands and returns the result
+ */
+template <
+    any_literal Symbol,
+    int Power,
+    assoc Associativity = assoc::left,
+    class Func>
+constexpr auto infix_op(Func&& func) {
+    return parsers::operator_def<
+        parsers::operator_kind::infix,
+        Symbol,
+        Power,
+        Associativity,
+        std::decay_t<Func>> {std::forward<Func>(func)};
+}
+/**
+ * @brief A postfix operator for an operator_table, such as `!` (factorial)
+ *
+ * @tparam Symbol the literal following the operand
+ * @tparam Power the binding power of the operator
+ * @param func takes the operand and returns the result
+ */
+template <any_literal Symbol, int Power, class Func>
+constexpr auto postfix_op(Func&& func) {
+    return parsers::operator_def<
+        parsers::operator_kind::postfix,
+        Symbol,
+        Power,
+        assoc::left,
+        std::decay_t<Func>> {std::forward<Func>(func)};
+}
+
+/**
+ * @brief Collects operators for noam::pratt. Operators are tried in order, so
+ * an operator must come before any operator whose symbol is a prefix of it
+ * ("**" before "*").
+ */
+template <class... Ops>
+constexpr auto operator_table(Ops... ops) {
+    return parsers::operator_table<Ops...> {ops...};
+}
+
+/**
+ * @brief Parses an expression of operands separated, preceded, and followed
+ * by the operators in `table`, grouping them by binding power and
+ * associativity. This replaces a tower of fold_left parsers (one per
+ * precedence tier) with a single loop, which parses each operand once:
+ *
+ * ```cpp
+ * constexpr auto arithmetic = noam::operator_table(
+ *     noam::infix_op<'+', 1>(std::plus<> {}),
+ *     noam::infix_op<'*', 2>(std::multiplies<> {}),
+ *     noam::infix_op<'^', 4, noam::assoc::right>(power),
+ *     noam::prefix_op<'-', 3>(std::negate<> {}));
+ * constexpr noam::parser expr = noam::pratt(noam::parse_int, arithmetic);
+ * ```
+ *
+ * Operators are matched right where the preceding operand or operator
+ * stopped, so to allow whitespace, have the operand parser skip it (see
+ * whitespace_enclose). Parenthesized expressions can be written as operands
+ * with noam::recurse.
+ *
+ * @param operand parses the operands, and gives the type of the expression
+ * @param table the operators, from noam::operator_table
+ */
+template <class Operand, class... Ops>
+constexpr auto pratt(Operand&& operand, parsers::operator_table<Ops...> table) {
+    auto base = parser {std::forward<Operand>(operand)};
+    return parser {parsers::pratt<decltype(base), Ops...> {
+        std::move(base),
+        std::move(table)}};
+}
+
 /**
  * @brief Maps a function over a parser, returning a new parser whose output is
  * func applied to the output of parser
@@ -114,24 +215,58 @@ constexpr auto either(Parser&& p) {
     }
 }
 
+/**
+ * @brief Declares that a parser only succeeds on input starting with a byte
+ * in `cls`. `either` uses this to skip alternatives which can't match, so
+ * it's useful for parsers written as lambdas, which have no FIRST set of
+ * their own.
+ *
+ * @tparam cls the bytes the input must start with
+ * @param p the parser
+ */
+template <char_class cls, class Parser>
+constexpr auto with_first_set(Parser&& p) {
+    auto base = parser {std::forward<Parser>(p)};
+    return parser {parsers::with_first_set<cls, decltype(base)> {
+        std::move(base)}};
+}
+
+/**
+ * @brief Gives `p` the union of the FIRST sets of the parsers P, if they all
+ * have one. This is the FIRST set of a parser which tries each of P, or which
+ * starts by parsing P.
+ */
+template <class... P, class Parser>
+constexpr auto with_first_set_of(Parser&& p) {
+    if constexpr ((first_set_of<P>().has_value() && ...)) {
+        constexpr char_class first = (*first_set_of<P>() | ...);
+        return with_first_set<first>(std::forward<Parser>(p));
+    } else {
+        return parser {std::forward<Parser>(p)};
+    }
+}
+
+// The fixed-size overloads of either skip alternatives which can't match the
+// next byte, judging by their FIRST sets (see first_set_of)
+
 template <class Value, class PA, class PB>
 constexpr auto either(PA&& pa, PB&& pb) {
     constexpr bool good = parser_always_good_v<PA> // <br>
                        || parser_always_good_v<PB>;
     using result_t = get_result_t<Value, good>;
-    return parser {
+    return with_first_set_of<PA, PB>(
         [pa = std::forward<PA>(pa),
          pb = std::forward<PB>(pb)](state_t st) -> result_t {
-            if (auto r = pa.parse(st)) {
+            if (auto r = parse_if_may_match(pa, st)) {
                 return {r.get_state(), std::move(r).get_value()};
             }
-            if (auto r = pb.parse(st)) {
+            if (auto r = parse_if_may_match(pb, st)) {
                 return {r.get_state(), std::move(r).get_value()};
             }
             if constexpr (!good) {
                 return {};
             }
-        }};
+        });
 }
 template <class Value, class PA, class PB, class PC>
 constexpr auto either(PA&& pa, PB&& pb, PC&& pc) {
@@ -139,23 +274,23 @@ constexpr auto either(PA&& pa, PB&& pb, PC&& pc) {
                        || parser_always_good_v<PB> // <br>
                        || parser_always_good_v<PC>;
     using result_t = get_result_t<Value, good>;
-    return parser {
+    return with_first_set_of<PA, PB, PC>(
         [pa = std::forward<PA>(pa),
          pb = std::forward<PB>(pb),
          pc = std::forward<PC>(pc)](state_t st) -> result_t {
-            if (auto r = pa.parse(st)) {
+            if (auto r = parse_if_may_match(pa, st)) {
                 return {r.get_state(), std::move(r).get_value()};
             }
-            if (auto r = pb.parse(st)) {
+            if (auto r = parse_if_may_match(pb, st)) {
                 return {r.get_state(), std::move(r).get_value()};
             }
-            if (auto r = pc.parse(st)) {
+            if (auto r = parse_if_may_match(pc, st)) {
                 return {r.get_state(), std::move(r).get_value()};
             }
             if constexpr (!good) {
                 return {};
             }
-        }};
+        });
 }
 template <class Value, class PA, class PB, class PC, class PD>
 constexpr auto either(PA&& pa, PB&& pb, PC&& pc, PD&& pd) {
@@ -164,31 +299,36 @@ constexpr auto either(PA&& pa, PB&& pb, PC&& pc, PD&& pd) {
                        || parser_always_good_v<PC> // <br>
                        || parser_always_good_v<PD>;
     using result_t = get_result_t<Value, good>;
-    return parser {
+    return with_first_set_of<PA, PB, PC, PD>(
         [pa = std::forward<PA>(pa),
          pb = std::forward<PB>(pb),
          pc = std::forward<PC>(pc),
          pd = std::forward<PD>(pd)](state_t st) -> result_t {
-            if (auto r = pa.parse(st)) {
+            if (auto r = parse_if_may_match(pa, st)) {
                 return {r.get_state(), std::move(r).get_value()};
             }
-            if (auto r = pb.parse(st)) {
+            if (auto r = parse_if_may_match(pb, st)) {
                 return {r.get_state(), std::move(r).get_value()};
             }
-            if (auto r = pc.parse(st)) {
+            if (auto r = parse_if_may_match(pc, st)) {
                 return {r.get_state(), std::move(r).get_value()};
             }
-            if (auto r = pd.parse(st)) {
+            if (auto r = parse_if_may_match(pd, st)) {
                 return {r.get_state(), std::move(r).get_value()};
             }
             if constexpr (!good) {
                 return {};
             }
-        }};
+        });
 }
 /**
  * @brief Creates a backtracking parser that will test each parser in sequence
  *
+ * The next byte of the input is looked up in a table built from the FIRST
+ * sets of the parsers, giving a mask of the alternatives which could match.
+ * Only those are tried, still in order, so the result is the same as trying
+ * every alternative. Parsers without a FIRST set are always tried.
+ *
  * @tparam P the types of the parsers to test
  * @param parsers the parsers to test
  * @return parser A parser that will test each input in sequence, returning the
@@ -198,20 +338,33 @@ template <class Value, class... P>
 constexpr auto either(P&&... parsers) {
     constexpr bool always_good = (parser_always_good_v<P> || ...);
     using result_t = get_result_t<Value, always_good>;
-    return parser {[... p = std::forward<P>(parsers)](state_t st) -> result_t {
-        // Non-default-constructible values are boxed so that they're
-        // default-constructible.
-        box_if_necessary_t<Value> val;
-        if constexpr (always_good) {
-            (parse_assign_value(st, p, val) || ...);
-            return {st, std::move(val)};
-        } else {
-            if ((parse_assign_value(st, p, val) || ...))
+    constexpr auto& dispatch = first_set_dispatch_for<std::decay_t<P>...>;
+    return with_first_set_of<P...>(
+        [... p = std::forward<P>(parsers)](state_t st) -> result_t {
+            // Non-default-constructible values are boxed so that they're
+            // default-constructible.
+            box_if_necessary_t<Value> val;
+            bool matched;
+            if constexpr (dispatch.useful) {
+                // i counts the alternatives as the fold visits them, so it's
+                // the bit of the current alternative
+                auto candidates = dispatch.candidates(st);
+                size_t i = 0;
+                matched = ((((candidates >> i++) & 1)
+                            && parse_assign_value(st, p, val))
+                           || ...);
+            } else {
+                matched = (parse_assign_value(st, p, val) || ...);
+            }
+            if constexpr (always_good) {
                 return {st, std::move(val)};
-            else
-                return {};
-        }
-    }};
+            } else {
+                if (matched)
+                    return {st, std::move(val)};
+                else
+                    return {};
+            }
+        });
 }
 
 template <class... P>
@@ -352,9 +505,11 @@ constexpr auto test_prefix(state_t prefix) {
     return [=](state_t state) {
         if (state.starts_with(prefix)) {
             return boolean_result {state.substr(prefix.size()), true};
-        } else {
-            return boolean_result {state, false};
         }
+        if (state.size() < prefix.size() && prefix.starts_with(state)) {
+            note_end_of_input();
+        }
+        return boolean_result {state, false};
     } / make_parser;
 }
 
@@ -369,9 +524,11 @@ constexpr auto require_prefix(state_t prefix) {
     return [=](state_t state) -> result<state_t> {
         if (state.starts_with(prefix)) {
             return {state.substr(prefix.size()), prefix};
-        } else {
-            return {};
         }
+        if (state.size() < prefix.size() && prefix.starts_with(state)) {
+            note_end_of_input();
+        }
+        return {};
     } / make_parser;
 }
 
@@ -521,6 +678,20 @@ constexpr auto make(P1&& first, P2&&... rest) {
         parsers::join {separator<sep>, std::forward<P2>(rest)}...);
 }
 
+/**
+ * @brief Reserves room for the first few elements of a sequence, if
+ * `container` has no capacity yet
+ */
+template <class Container>
+constexpr void reserve_initial(Container& container) {
+    constexpr size_t initial_reserve = 16;
+    if constexpr (requires { container.reserve(initial_reserve); }) {
+        if (container.capacity() == 0) {
+            container.reserve(initial_reserve);
+        }
+    }
+}
+
 /**
  * @brief Parses a sequence of elements, returning the result as a vector
  *
@@ -532,31 +703,16 @@ constexpr auto make(P1&& first, P2&&... rest) {
  */
 template <any_literal Sep, class P>
 constexpr auto sequence(P&& elem) {
-    constexpr int initial_reserve = 16;
     using T = parser_value_t<P>;
     using result_t = pure_result<std::vector<T>>;
     return parser {[elem = std::forward<P>(elem)](state_t st) -> result_t {
         constexpr auto sep = separator<Sep>;
-        if (auto first = elem.parse(st)) {
-            // Update the state since we obtained the first value
-            st = first.get_state();
-
-            std::vector<T> value;
-            value.reserve(initial_reserve);
-            value.push_back(std::move(first).get_value());
-            while (auto sep_result = sep.parse(st)) {
-                if (auto next = elem.parse(sep_result.get_state())) {
-                    // Update the state since we obtained the next value
-                    st = next.get_state();
-                    value.push_back(std::move(next).get_value());
-                } else {
-                    break;
-                }
-            }
-            return {st, std::move(value)};
-        } else {
-            return {st, std::vector<T>()};
-        }
+        std::vector<T> value;
+        st = parse_elements(elem, sep, st, [&](auto&& next) {
+            reserve_initial(value);
+            value.push_back(std::forward<decltype(next)>(next));
+        });
+        return {st, std::move(value)};
     }};
 }
 template <
@@ -565,10 +721,11 @@ template <
     any_literal Closing,
     class P>
 constexpr auto sequence(P&& elem) {
-    constexpr int initial_reserve = 16;
     using T = parser_value_t<P>;
     using result_t = result<std::vector<T>>;
-    return parser {[elem = std::forward<P>(elem)](state_t st) -> result_t {
+    using opening_t = decltype(literal<Opening>);
+    return with_first_set_of<opening_t>([elem = std::forward<P>(elem)](
+                                            state_t st) -> result_t {
         constexpr auto open = parsers::match {literal<Opening>, whitespace};
         constexpr auto close = parsers::match {whitespace, literal<Closing>};
         constexpr auto sep = separator<Separator>;
@@ -576,25 +733,14 @@ constexpr auto sequence(P&& elem) {
             return null_result;
 
         std::vector<T> value;
-        if (auto first = elem.parse(st)) {
-            // Update the state since we obtained the first value
-            st = first.get_state();
-            value.reserve(initial_reserve);
-            value.push_back(std::move(first).get_value());
-            while (auto sep_result = sep.parse(st)) {
-                if (auto next = elem.parse(sep_result.get_state())) {
-                    // Update the state since we obtained the next value
-                    st = next.get_state();
-                    value.push_back(std::move(next).get_value());
-                } else {
-                    break;
-                }
-            }
-        }
+        st = parse_elements(elem, sep, st, [&](auto&& next) {
+            reserve_initial(value);
+            value.push_back(std::forward<decltype(next)>(next));
+        });
         return update_state(close.parse(st), st)
                  ? result_t {st, std::move(value)}
                  : null_result;
-    }};
+    });
 }
 template <any_literal Opening, any_literal Closing, class P>
 constexpr auto sequence(P&& elem) {
@@ -615,34 +761,303 @@ constexpr auto sequence(P&& elem) {
  */
 template <class ParseElem, class ParseSep>
 constexpr auto sequence(ParseElem&& elem, ParseSep&& sep) {
-    constexpr int initial_reserve = 16;
     using T = parser_value_t<ParseElem>;
     return parser {
         [elem = std::forward<ParseElem>(elem),
          sep = std::forward<ParseSep>(sep)](
             state_t st) -> pure_result<std::vector<T>> {
-            if (auto first = elem.parse(st)) {
-                // Update the state since we obtained the first value
-                st = first.get_state();
+            std::vector<T> value;
+            st = parse_elements(elem, sep, st, [&](auto&& next) {
+                reserve_initial(value);
+                value.push_back(std::forward<decltype(next)>(next));
+            });
+            return {st, std::move(value)};
+        }};
+}
 
-                std::vector<T> value;
-                value.reserve(initial_reserve);
-                value.push_back(std::move(first).get_value());
-                while (auto sep_ = sep.parse(st)) {
-                    if (auto next = elem.parse(sep_.get_state())) {
-                        // Update the state since we obtained the next value
-                        st = next.get_state();
-                        value.push_back(std::move(next).get_value());
-                    } else {
-                        break;
-                    }
-                }
-                return {st, std::move(value)};
-            } else {
-                return {st, std::vector<T>()};
-            }
+/**
+ * @brief Parses a sequence of elements into a container of your choice, such
+ * as a std::pmr::vector, or a small vector with inline capacity (so that
+ * short sequences don't allocate). The container is constructed from `args`,
+ * which is how an allocator is passed:
+ *
+ * ```cpp
+ * std::pmr::monotonic_buffer_resource arena;
+ * auto ints = noam::sequence_as<std::pmr::vector<int>, '[', ',', ']'>(
+ *     noam::parse_int,
+ *     &arena);
+ * ```
+ *
+ * Elements are added with `push_back`. Like sequence, room for 16 elements is
+ * reserved when the first element is parsed, but only if the container has a
+ * `reserve` member and no capacity of its own, so a small vector's inline
+ * capacity is used before anything is allocated.
+ *
+ * @tparam Container the type of container to produce
+ * @tparam Sep the separator between elements
+ * @param elem parses each element
+ * @param args arguments used to construct each container (they're copied
+ * into the parser)
+ */
+template <class Container, any_literal Sep = ',', class P, class... Args>
+constexpr auto sequence_as(P&& elem, Args&&... args) {
+    using result_t = pure_result<Container>;
+    return parser {[elem = std::forward<P>(elem),
+                    ... args = std::forward<Args>(args)](state_t st)
+                       -> result_t {
+        constexpr auto sep = separator<Sep>;
+        Container value(args...);
+        st = parse_elements(elem, sep, st, [&](auto&& next) {
+            reserve_initial(value);
+            value.push_back(std::forward<decltype(next)>(next));
+        });
+        return {st, std::move(value)};
+    }};
+}
+template <
+    class Container,
+    any_literal Opening,
+    any_literal Separator,
+    any_literal Closing,
+    class P,
+    class... Args>
+constexpr auto sequence_as(P&& elem, Args&&... args) {
+    using result_t = result<Container>;
+    using opening_t = decltype(literal<Opening>);
+    return with_first_set_of<opening_t>(
+        [elem = std::forward<P>(elem),
+         ... args = std::forward<Args>(args)](state_t st) -> result_t {
+            constexpr auto open = parsers::match {literal<Opening>, whitespace};
+            constexpr auto close = parsers::match {
+                whitespace,
+                literal<Closing>};
+            constexpr auto sep = separator<Separator>;
+            if (!update_state(open.parse(st), st))
+                return null_result;
+
+            Container value(args...);
+            st = parse_elements(elem, sep, st, [&](auto&& next) {
+                reserve_initial(value);
+                value.push_back(std::forward<decltype(next)>(next));
+            });
+            return update_state(close.parse(st), st)
+                     ? result_t {st, std::move(value)}
+                     : null_result;
+        });
+}
+
+/**
+ * @brief Parses a sequence of elements, appending them to `out`. The value
+ * of the parser is the number of elements appended. Clearing `out` between
+ * parses keeps its capacity, so a loop parsing many sequences allocates only
+ * when a sequence is longer than any before it:
+ *
+ * ```cpp
+ * std::vector<int> row;
+ * auto parse_row = noam::sequence_into(row, noam::parse_int);
+ * for (auto line : lines) {
+ *     row.clear();
+ *     parse_row.parse(line);
+ *     // use row
+ * }
+ * ```
+ *
+ * The parser refers to `out`, so `out` must outlive it.
+ *
+ * @tparam Sep the separator between elements
+ * @param out the container to append to (with `push_back`)
+ * @param elem parses each element
+ */
+template <any_literal Sep = ',', class Container, class P>
+constexpr auto sequence_into(Container& out, P&& elem) {
+    using result_t = pure_result<size_t>;
+    return parser {
+        [&out, elem = std::forward<P>(elem)](state_t st) -> result_t {
+            constexpr auto sep = separator<Sep>;
+            size_t count = 0;
+            st = parse_elements(elem, sep, st, [&](auto&& next) {
+                out.push_back(std::forward<decltype(next)>(next));
+                count++;
+            });
+            return {st, count};
         }};
 }
+/**
+ * @brief Parses a bracketed sequence of elements, appending them to `out`.
+ * If the sequence isn't closed, the parse fails, and the elements appended
+ * are erased again.
+ */
+template <
+    any_literal Opening,
+    any_literal Separator,
+    any_literal Closing,
+    class Container,
+    class P>
+constexpr auto sequence_into(Container& out, P&& elem) {
+    using result_t = result<size_t>;
+    using opening_t = decltype(literal<Opening>);
+    return with_first_set_of<opening_t>(
+        [&out, elem = std::forward<P>(elem)](state_t st) -> result_t {
+            constexpr auto open = parsers::match {literal<Opening>, whitespace};
+            constexpr auto close = parsers::match {
+                whitespace,
+                literal<Closing>};
+            constexpr auto sep = separator<Separator>;
+            if (!update_state(open.parse(st), st))
+                return null_result;
+
+            size_t count = 0;
+            st = parse_elements(elem, sep, st, [&](auto&& next) {
+                out.push_back(std::forward<decltype(next)>(next));
+                count++;
+            });
+            if (!update_state(close.parse(st), st)) {
+                out.erase(std::prev(out.end(), count), out.end());
+                return null_result;
+            }
+            return result_t {st, count};
+        });
+}
+
+/**
+ * @brief Parses a sequence of elements in two passes: the first counts the
+ * elements, and the second parses them into a vector allocated once, with
+ * exactly enough room. Growing a vector geometrically leaves up to half its
+ * capacity unused, and needs the old and new buffers at once while it moves
+ * the elements, so counting first lowers the peak memory used by a long
+ * sequence. It's slower when elements are cheap to move, since counting them
+ * costs as much as parsing them.
+ *
+ * Each element is parsed twice, so `elem` must give the same result each time
+ * it's applied to the same input.
+ *
+ * @tparam Sep the separator between elements
+ * @param elem parses each element
+ */
+template <any_literal Sep = ',', class P>
+constexpr auto sequence_exact(P&& elem) {
+    using T = parser_value_t<P>;
+    using result_t = pure_result<std::vector<T>>;
+    return parser {[elem = std::forward<P>(elem)](state_t st) -> result_t {
+        constexpr auto sep = separator<Sep>;
+        size_t count = 0;
+        parse_elements(elem, sep, st, [&](auto&&) { count++; });
+        std::vector<T> value;
+        value.reserve(count);
+        st = parse_elements(elem, sep, st, [&](auto&& next) {
+            value.push_back(std::forward<decltype(next)>(next));
+        });
+        return {st, std::move(value)};
+    }};
+}
+/**
+ * @brief Parses a bracketed sequence of elements in two passes (see above).
+ * If the sequence isn't closed, the parse fails without allocating.
+ */
+template <
+    any_literal Opening,
+    any_literal Separator,
+    any_literal Closing,
+    class P>
+constexpr auto sequence_exact(P&& elem) {
+    using T = parser_value_t<P>;
+    using result_t = result<std::vector<T>>;
+    using opening_t = decltype(literal<Opening>);
+    return with_first_set_of<opening_t>([elem = std::forward<P>(elem)](
+                                            state_t st) -> result_t {
+        constexpr auto open = parsers::match {literal<Opening>, whitespace};
+        constexpr auto close = parsers::match {whitespace, literal<Closing>};
+        constexpr auto sep = separator<Separator>;
+        if (!update_state(open.parse(st), st))
+            return null_result;
+
+        size_t count = 0;
+        state_t end = parse_elements(elem, sep, st, [&](auto&&) { count++; });
+        if (!update_state(close.parse(end), end))
+            return null_result;
+
+        std::vector<T> value;
+        value.reserve(count);
+        parse_elements(elem, sep, st, [&](auto&& next) {
+            value.push_back(std::forward<decltype(next)>(next));
+        });
+        return result_t {end, std::move(value)};
+    });
+}
+
+/**
+ * @brief Parses exactly `N` elements, with nothing between them, returning
+ * them as a std::array<T, N>. Use this instead of sequence when the number
+ * of elements is known: nothing is allocated, and the parse is unrolled.
+ *
+ * @tparam N the number of elements
+ * @param elem parses each element
+ */
+template <size_t N, class P>
+constexpr auto repeat(P&& elem) {
+    auto elem_parser = parser {std::forward<P>(elem)};
+    using no_separator = parsers::pure<empty>;
+    return parser {parsers::repeat<N, decltype(elem_parser), no_separator> {
+        std::move(elem_parser),
+        no_separator {}}};
+}
+/**
+ * @brief Parses exactly `N` elements separated by `sep`, returning them as a
+ * std::array<T, N>:
+ *
+ * ```cpp
+ * // "255, 128, 0" -> {255, 128, 0}
+ * auto rgb = noam::repeat<3>(noam::parse_uint8, noam::comma_separator);
+ * ```
+ *
+ * @tparam N the number of elements
+ * @param elem parses each element
+ * @param sep parses the separator between elements
+ */
+template <size_t N, class P, class Sep>
+constexpr auto repeat(P&& elem, Sep&& sep) {
+    auto elem_parser = parser {std::forward<P>(elem)};
+    auto sep_parser = parser {std::forward<Sep>(sep)};
+    using repeat_t = parsers::
+        repeat<N, decltype(elem_parser), decltype(sep_parser)>;
+    return parser {repeat_t {std::move(elem_parser), std::move(sep_parser)}};
+}
+/**
+ * @brief Parses between `Min` and `Max` elements, with nothing between them,
+ * returning them as a noam::static_vector<T, Max>, which holds its elements
+ * inline instead of allocating them. Parsing stops after `Max` elements, and
+ * fails if there are fewer than `Min`.
+ *
+ * @tparam Min the fewest elements to accept
+ * @tparam Max the most elements to parse
+ * @param elem parses each element
+ */
+template <size_t Min, size_t Max, class P>
+constexpr auto repeat(P&& elem) {
+    auto elem_parser = parser {std::forward<P>(elem)};
+    using no_separator = parsers::pure<empty>;
+    using repeat_t = parsers::
+        repeat_between<Min, Max, decltype(elem_parser), no_separator>;
+    return parser {repeat_t {std::move(elem_parser), no_separator {}}};
+}
+/**
+ * @brief Parses between `Min` and `Max` elements separated by `sep`,
+ * returning them as a noam::static_vector<T, Max>. A separator which isn't
+ * followed by an element is left in the input.
+ *
+ * @tparam Min the fewest elements to accept
+ * @tparam Max the most elements to parse
+ * @param elem parses each element
+ * @param sep parses the separator between elements
+ */
+template <size_t Min, size_t Max, class P, class Sep>
+constexpr auto repeat(P&& elem, Sep&& sep) {
+    auto elem_parser = parser {std::forward<P>(elem)};
+    auto sep_parser = parser {std::forward<Sep>(sep)};
+    using repeat_t = parsers::
+        repeat_between<Min, Max, decltype(elem_parser), decltype(sep_parser)>;
+    return parser {repeat_t {std::move(elem_parser), std::move(sep_parser)}};
+}
 
 template <
     class Map,
@@ -656,7 +1071,8 @@ constexpr auto parse_map(K&& key, V&& val) {
     using KeyT = parser_value_t<K>;
     using ValT = parser_value_t<V>;
     using result_t = result<Map>;
-    return parser {
+    using opening_t = decltype(literal<Opening>);
+    return with_first_set_of<opening_t>(
         [elem = noam::make<tuplet::pair, KeyValueSeparator>(
              std::forward<K>(key),
              std::forward<V>(val))](state_t st) -> result_t {
@@ -692,7 +1108,7 @@ constexpr auto parse_map(K&& key, V&& val) {
             return update_state(close.parse(st), st)
                      ? result_t {st, std::move(map)}
                      : null_result;
-        }};
+        });
 }
 
 template <class Map, any_literal Opening, any_literal Closing, class K, class V>
@@ -707,6 +1123,100 @@ constexpr auto parse_map(K&& key, V&& val) {
         std::forward<K>(key),
         std::forward<V>(val));
 }
+/**
+ * @brief The key-value pairs of maps being parsed by parse_map_bulk, for
+ * maps which don't keep them. A map nested in the values of another map
+ * adds its pairs after those of the outer map, and removes them once it's
+ * built, so one buffer (and its capacity) is shared by every map parsed on a
+ * thread.
+ */
+template <class Pair>
+std::vector<Pair>& pending_pairs() {
+    thread_local std::vector<Pair> pairs;
+    return pairs;
+}
+
+/**
+ * @brief Parses a map like parse_map, but collects the key-value pairs in a
+ * contiguous buffer and builds the map in bulk once the map is closed (see
+ * noam::build_map). This avoids rebalancing a std::map or rehashing a
+ * std::unordered_map as keys are added, and a noam::flat_map is sorted once
+ * and keeps the buffer as its storage.
+ *
+ * ```cpp
+ * using object = noam::flat_map<std::string_view, json_value>;
+ * auto parse_object = noam::parse_map_bulk<object>(
+ *     noam::parse_string_view,
+ *     parse_value);
+ * ```
+ *
+ * @tparam Map the type of map to build
+ * @tparam Duplicates which value is kept if a key appears more than once, or
+ * duplicate_keys::fail to fail the parse instead
+ * @param key parses each key
+ * @param val parses each value
+ */
+template <
+    class Map,
+    duplicate_keys Duplicates = duplicate_keys::keep_first,
+    any_literal Opening = '{',
+    any_literal ElemSeparator = ',',
+    any_literal KeyValueSeparator = ':',
+    any_literal Closing = '}',
+    class K,
+    class V>
+constexpr auto parse_map_bulk(K&& key, V&& val) {
+    // Keys and values are converted to the map's types as they're collected,
+    // so that they can be sorted with the map's comparison
+    using pair_t =
+        std::pair<typename Map::key_type, typename Map::mapped_type>;
+    using result_t = result<Map>;
+    using opening_t = decltype(literal<Opening>);
+    // Flat maps keep the pairs they're built from, so they can't share a
+    // buffer
+    constexpr bool keeps_pairs = requires {
+        Map(sorted_unique, std::vector<pair_t>());
+    };
+    return with_first_set_of<opening_t>(
+        [elem = noam::make<tuplet::pair, KeyValueSeparator>(
+             std::forward<K>(key),
+             std::forward<V>(val))](state_t st) -> result_t {
+            constexpr auto open = parsers::match {literal<Opening>, whitespace};
+            constexpr auto close = parsers::match {
+                whitespace,
+                literal<Closing>};
+            constexpr auto sep = separator<ElemSeparator>;
+            if (!update_state(open.parse(st), st))
+                return null_result;
+
+            std::vector<pair_t> own_pairs;
+            auto& pairs = keeps_pairs ? own_pairs : pending_pairs<pair_t>();
+            size_t start = pairs.size();
+            // The pairs of this map are removed however the parse ends,
+            // including if a parser throws
+            struct erase_pairs {
+                std::vector<pair_t>& pairs;
+                size_t start;
+                ~erase_pairs() {
+                    pairs.erase(pairs.begin() + start, pairs.end());
+                }
+            } erase {pairs, start};
+            st = parse_elements(elem, sep, st, [&](auto&& next) {
+                reserve_initial(pairs);
+                auto& [key, val] = next;
+                pairs.emplace_back(std::move(key), std::move(val));
+            });
+            if (!update_state(close.parse(st), st)) {
+                return null_result;
+            }
+            auto map = build_map<Map, Duplicates>(pairs, start);
+            if (!map) {
+                return null_result;
+            }
+            return result_t {st, std::move(*map)};
+        });
+}
+
 template <class T, class Func>
 constexpr auto recurse(Func&& func) {
     return parser {parsers::recurse<T, Func> {func}};
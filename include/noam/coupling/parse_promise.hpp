@@ -2,6 +2,8 @@
 #include <noam/coupling/await_parser.hpp>
 #include <noam/parser.hpp>
 #include <noam/result_types.hpp>
+#include <noam/util/frame_pool.hpp>
+#include <optional>
 #include <tuple>
 
 namespace noam {
@@ -16,35 +18,46 @@ class parse_promise_to_result {
    public:
     parse_promise_to_result(handle_t handle) noexcept
       : handle(handle) {}
+    /**
+     * @brief Runs the coroutine to completion. On success, the value is moved
+     * out of the promise and into the result.
+     */
     operator result<T>() const {
         handle.resume();
         auto& promise = handle.promise();
-        if (promise.is_good) {
-            return {promise.state, promise.value};
+        if (promise.value) {
+            return {promise.state, std::move(*promise.value)};
         } else {
             return {};
         }
     }
     ~parse_promise_to_result() { handle.destroy(); }
 };
+/**
+ * @brief Promise type for coroutine parsers. Coroutine frames are allocated
+ * through noam::frame_allocation, which pools them per thread unless
+ * NOAM_COROUTINE_FRAME_POOL is 0.
+ *
+ * @tparam T the value produced by the coroutine
+ */
 template <class T>
-struct parse_promise {
+struct parse_promise : frame_allocation {
     using handle_t = std::coroutine_handle<parse_promise>;
     state_t state;
-    T value;
-    bool is_good = false;
+    // The value is left unconstructed until the coroutine co_returns. This
+    // means T doesn't need to be default constructible, and the value is
+    // constructed in place rather than being assigned to.
+    std::optional<T> value;
 
-    constexpr operator bool() const noexcept { return is_good; }
+    constexpr operator bool() const noexcept { return value.has_value(); }
     constexpr state_t get_state() const noexcept { return state; }
     constexpr void set_state(state_t new_state) noexcept { state = new_state; }
-    constexpr decltype(auto) get_value() & noexcept { return value; }
-    constexpr decltype(auto) get_value() const& noexcept { return value; }
+    constexpr decltype(auto) get_value() & noexcept { return *value; }
+    constexpr decltype(auto) get_value() const& noexcept { return *value; }
     constexpr decltype(auto) get_value() && noexcept {
-        return std::move(*this).value;
+        return std::move(*value);
     }
     parse_promise() = default;
-    parse_promise(parse_promise const&) = default;
-    parse_promise(parse_promise&&) = default;
     parse_promise(state_t state) noexcept
       : state(state) {}
     parse_promise(auto&& context, state_t state) noexcept
@@ -53,14 +66,9 @@ struct parse_promise {
     constexpr std::suspend_always initial_suspend() noexcept { return {}; }
     constexpr std::suspend_always final_suspend() noexcept { return {}; }
 
-    void return_value(T const& value) {
-        this->value = value;
-        is_good = true;
-    }
-    void return_value(T&& value) {
-        this->value = std::move(value);
-        is_good = true;
-    }
+    void return_value(T const& value) { this->value.emplace(value); }
+    void return_value(T&& value) { this->value.emplace(std::move(value)); }
+
     template <class F>
     auto await_transform(F&& func) {
         return await_parser<F> {std::forward<F>(func), &state};
@@ -73,7 +81,7 @@ struct parse_promise {
 
     void unhandled_exception() {
         // Fuck this shit we just cancelling it all
-        is_good = false;
+        value.reset();
     }
 
     /**
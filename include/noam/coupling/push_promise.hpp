@@ -0,0 +1,154 @@
+#pragma once
+#include <noam/parser.hpp>
+#include <noam/result_types.hpp>
+#include <noam/type_traits.hpp>
+#include <noam/util/frame_pool.hpp>
+#include <noam/util/partial_input.hpp>
+#include <noam/util/stdlib_coroutine.hpp>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace noam {
+/**
+ * @brief Status of a push-mode parser after being given input
+ *
+ */
+enum class push_status {
+    // The parser is suspended, waiting for more input (or for finish())
+    need_more,
+    // The parser completed successfully and produced a value
+    done,
+    // The parser failed
+    failed
+};
+
+/**
+ * @brief The input buffer shared between a push-mode coroutine and the
+ * push_parser driving it. Input that has been consumed by the coroutine is
+ * discarded the next time more input is pushed.
+ *
+ */
+struct push_input {
+    std::string buffer;
+    // Number of bytes at the front of the buffer which have been consumed
+    size_t consumed = 0;
+    // The awaited parser isn't run again until this many bytes remain, so
+    // that a long token arriving in small fragments isn't parsed once per
+    // fragment. This doubles each time the parse can't be accepted.
+    size_t retry_size = 0;
+    bool finished = false;
+    bool failed = false;
+
+    // If the coroutine is suspended waiting on more input, this re-runs the
+    // awaited parser against the current buffer and returns true if the
+    // coroutine can now be resumed
+    bool (*retry)(void*) = nullptr;
+    void* pending = nullptr;
+
+    state_t remaining() const noexcept {
+        return state_t(buffer.data() + consumed, buffer.data() + buffer.size());
+    }
+    void consume_until(char const* pos) noexcept {
+        consumed = pos - buffer.data();
+    }
+};
+
+/**
+ * @brief Awaitable used by push-mode coroutines. Behaves like await_parser,
+ * except that a parse which can't yet be known to be final suspends the
+ * coroutine until more input arrives.
+ *
+ * While the input is unfinished, the parser is run with a partial_input
+ * installed, and its result is only accepted if it succeeded, stopped before
+ * the end of the input, and no parser it ran reached the end of the input
+ * (see noam::partial_input). Any other outcome might change once more input
+ * arrives, so the parser is run again from the same position once the
+ * remaining input has doubled in size, or the input is finished. Once the
+ * input is finished, results are accepted as-is, and a failure fails the
+ * whole coroutine.
+ *
+ * @tparam Parser the parser being awaited
+ */
+template <class Parser>
+struct push_await_parser {
+    Parser parser;
+    push_input* input = nullptr;
+
+    using result_t = default_constructible_parser_result_t<Parser>;
+    result_t result {};
+
+    bool try_parse() {
+        state_t remaining = input->remaining();
+        if (input->finished) {
+            result = parser.parse(remaining);
+            if (result) {
+                input->consume_until(result.get_state().data());
+                return true;
+            }
+            input->failed = true;
+            return false;
+        }
+        if (size_t(remaining.size()) < input->retry_size) {
+            return false;
+        }
+        bool accepted;
+        {
+            partial_input partial;
+            result = parser.parse(remaining);
+            accepted = result && !result.get_state().empty()
+                    && !partial.reached_end();
+        }
+        if (accepted) {
+            input->consume_until(result.get_state().data());
+            input->retry_size = 0;
+            return true;
+        }
+        input->retry_size = 2 * size_t(remaining.size());
+        return false;
+    }
+
+    bool await_ready() { return try_parse(); }
+    void await_suspend(std::coroutine_handle<>) noexcept {
+        input->pending = this;
+        input->retry = [](void* self) {
+            return static_cast<push_await_parser*>(self)->try_parse();
+        };
+    }
+    decltype(auto) await_resume() & noexcept {
+        return std::move(result).get_value();
+    }
+};
+
+template <class T>
+class push_parser;
+
+/**
+ * @brief Promise type for push-mode coroutine parsers
+ *
+ * @tparam T the value produced by the coroutine
+ */
+template <class T>
+struct push_promise : frame_allocation {
+    using handle_t = std::coroutine_handle<push_promise>;
+    push_input input;
+    std::optional<T> value;
+
+    constexpr std::suspend_always initial_suspend() noexcept { return {}; }
+    constexpr std::suspend_always final_suspend() noexcept { return {}; }
+
+    void return_value(T const& value) { this->value.emplace(value); }
+    void return_value(T&& value) { this->value.emplace(std::move(value)); }
+
+    template <class F>
+    auto await_transform(F&& func) {
+        return push_await_parser<F> {std::forward<F>(func), &input};
+    }
+
+    void unhandled_exception() { input.failed = true; }
+
+    push_parser<T> get_return_object() {
+        return push_parser<T> {handle_t::from_promise(*this)};
+    }
+};
+} // namespace noam
@@ -0,0 +1,319 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <noam/parser.hpp>
+#include <noam/result_types.hpp>
+#include <noam/state.hpp>
+#include <noam/util/partial_input.hpp>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace noam {
+/**
+ * @brief A set of words, built at runtime, which finds the longest word
+ * prefixing the input. This is for vocabularies that are too large, or not
+ * known early enough, to be written as literals (such as keywords or codes
+ * loaded from a file at startup).
+ *
+ * Words are stored in a double-array trie. Each node is a slot in a single
+ * array, and the child of a node for byte `c` is at slot `base + c + 1`,
+ * which is the child only if its `check` field names the parent. Following an
+ * edge is one load, no matter how many children a node has, and the base,
+ * check, and id of a node are stored together.
+ *
+ * ```cpp
+ * noam::dictionary codes(std::vector<std::string> {"AB", "ABC", "X"});
+ * size_t length;
+ * size_t id = codes.find("ABCD", length); // id = 1, length = 3
+ * ```
+ *
+ * The dictionary doesn't refer to the words it was built from, so they don't
+ * need to outlive it.
+ *
+ */
+class dictionary {
+    constexpr static uint32_t no_id = 0xffffffff;
+    constexpr static int32_t free_slot = -1;
+
+    struct node {
+        // Children of this node are at base + byte + 1
+        int32_t base = 0;
+        // The parent of this node, or free_slot if the slot is unused
+        int32_t check = free_slot;
+        // The id of the word ending at this node, if any
+        uint32_t id = no_id;
+    };
+    std::vector<node> nodes;
+    size_t word_count = 0;
+
+    struct entry {
+        std::string_view word;
+        uint32_t id;
+    };
+
+    /**
+     * @brief Assigns slots to nodes while the trie is being built. Free slots
+     * are kept in a circular list, so finding a base doesn't scan slots which
+     * are in use. Slot 0 (the root) is never free, so it's the head of the
+     * list.
+     */
+    struct slot_allocator {
+        std::vector<node>& nodes;
+        std::vector<int32_t> next;
+        std::vector<int32_t> prev;
+        // How many times each slot has failed to give a base. Slots that fail
+        // often are in crowded regions, so they're dropped from the list.
+        std::vector<uint8_t> tries;
+        constexpr static uint8_t max_tries = 16;
+
+        slot_allocator(std::vector<node>& nodes)
+          : nodes(nodes) {
+            nodes.assign(1, node {});
+            nodes[0].check = 0;
+            next.assign(1, 0);
+            prev.assign(1, 0);
+            tries.assign(1, 0);
+        }
+
+        void unlink(int32_t slot) {
+            if (prev[slot] < 0) {
+                return;
+            }
+            next[prev[slot]] = next[slot];
+            prev[next[slot]] = prev[slot];
+            prev[slot] = -1;
+        }
+        void grow(size_t size) {
+            size_t old_size = nodes.size();
+            if (size <= old_size) {
+                return;
+            }
+            size = std::max(size, old_size * 2);
+            nodes.resize(size);
+            next.resize(size);
+            prev.resize(size);
+            tries.resize(size);
+            for (size_t slot = old_size; slot < size; slot++) {
+                int32_t last = prev[0];
+                next[last] = int32_t(slot);
+                prev[slot] = last;
+                next[slot] = 0;
+                prev[0] = int32_t(slot);
+            }
+        }
+        bool is_free(size_t slot) {
+            grow(slot + 1);
+            return nodes[slot].check == free_slot;
+        }
+        void occupy(int32_t slot, int32_t parent) {
+            nodes[slot].check = parent;
+            unlink(slot);
+        }
+
+        /**
+         * @brief Finds a base where a slot is free for each byte in `bytes`
+         */
+        int32_t find_base(std::vector<unsigned char> const& bytes) {
+            size_t offset = size_t(bytes[0]) + 1;
+            int32_t slot = next[0];
+            while (true) {
+                if (slot == 0) {
+                    // Every free slot has been tried, so add more
+                    int32_t last = prev[0];
+                    grow(nodes.size() + 1);
+                    slot = next[last];
+                }
+                if (size_t(slot) < offset) {
+                    slot = next[slot];
+                    continue;
+                }
+                size_t base = slot - offset;
+                bool fits = std::all_of(
+                    bytes.begin() + 1,
+                    bytes.end(),
+                    [&](auto b) { return is_free(base + b + 1); });
+                if (fits) {
+                    return int32_t(base);
+                }
+                // Checking the other slots may have added slots to the list,
+                // so the next slot is read afterwards
+                int32_t following = next[slot];
+                if (++tries[slot] == max_tries) {
+                    unlink(slot);
+                }
+                slot = following;
+            }
+        }
+    };
+
+    struct task {
+        int32_t node;
+        size_t lo;
+        size_t hi;
+        size_t depth;
+    };
+
+    void build(std::vector<entry>& entries) {
+        // Sorting groups words by prefix, so the words below each node are a
+        // contiguous range. It's stable, so duplicates keep the lowest id.
+        std::stable_sort(
+            entries.begin(),
+            entries.end(),
+            [](entry const& a, entry const& b) { return a.word < b.word; });
+
+        slot_allocator slots(nodes);
+        std::vector<task> tasks {{0, 0, entries.size(), 0}};
+        std::vector<unsigned char> bytes;
+        std::vector<size_t> starts;
+        while (!tasks.empty()) {
+            auto [parent, lo, hi, depth] = tasks.back();
+            tasks.pop_back();
+            // Words ending here sort before words continuing past it
+            if (lo < hi && entries[lo].word.size() == depth) {
+                nodes[parent].id = entries[lo].id;
+            }
+            while (lo < hi && entries[lo].word.size() == depth) {
+                lo++;
+            }
+            if (lo == hi) {
+                continue;
+            }
+            bytes.clear();
+            starts.clear();
+            for (size_t i = lo; i < hi; i++) {
+                unsigned char byte = entries[i].word[depth];
+                if (bytes.empty() || bytes.back() != byte) {
+                    bytes.push_back(byte);
+                    starts.push_back(i);
+                }
+            }
+            starts.push_back(hi);
+
+            int32_t base = slots.find_base(bytes);
+            nodes[parent].base = base;
+            for (size_t i = 0; i < bytes.size(); i++) {
+                int32_t child = base + bytes[i] + 1;
+                slots.occupy(child, parent);
+                tasks.push_back({child, starts[i], starts[i + 1], depth + 1});
+            }
+        }
+        // Trim the unused slots at the end, keeping room for the largest
+        // child slot of any node, so lookups never need a bounds check
+        size_t used = nodes.size();
+        while (used > 1 && nodes[used - 1].check == free_slot) {
+            used--;
+        }
+        nodes.resize(used + 256 + 1);
+        nodes.shrink_to_fit();
+    }
+
+   public:
+    /**
+     * @brief Builds a dictionary from a range of words. Each word's id is its
+     * position in the range. If a word appears more than once, it keeps the
+     * first id.
+     *
+     * @param words a range of strings (or anything convertible to
+     * std::string_view)
+     */
+    template <class Range>
+    explicit dictionary(Range const& words) {
+        std::vector<entry> entries;
+        for (auto const& word : words) {
+            entries.push_back({std::string_view(word), uint32_t(word_count)});
+            word_count++;
+        }
+        build(entries);
+    }
+    dictionary(std::initializer_list<std::string_view> words)
+      : dictionary(std::vector<std::string_view>(words)) {}
+
+    /**
+     * @brief The number of words the dictionary was built from, including
+     * duplicates. Ids are less than this.
+     */
+    size_t size() const noexcept { return word_count; }
+
+    /**
+     * @brief The number of slots in the trie, which is a measure of its size
+     * in memory
+     */
+    size_t slot_count() const noexcept { return nodes.size(); }
+
+    /**
+     * @brief Returned by find if no word prefixes the input
+     */
+    constexpr static size_t npos = size_t(-1);
+
+    /**
+     * @brief Finds the longest word which is a prefix of the input
+     *
+     * @param length set to the length of the word, if one matches
+     * @return size_t the id of the word, or npos
+     */
+    size_t find(state_t st, size_t& length) const noexcept {
+        node const* data = nodes.data();
+        uint32_t best = data[0].id;
+        length = 0;
+        int32_t current = 0;
+        size_t size = st.size();
+        for (size_t depth = 0; depth < size; depth++) {
+            int32_t child = data[current].base + (unsigned char)st[depth] + 1;
+            if (data[child].check != current) {
+                return best == no_id ? npos : best;
+            }
+            current = child;
+            if (data[current].id != no_id) {
+                best = data[current].id;
+                length = depth + 1;
+            }
+        }
+        // The input ran out, so a longer word may still match
+        note_end_of_input();
+        return best == no_id ? npos : best;
+    }
+
+    /**
+     * @brief Checks if the dictionary contains exactly this word, and if so,
+     * returns its id (or npos otherwise)
+     */
+    size_t id_of(std::string_view word) const noexcept {
+        size_t length = 0;
+        size_t id = find(word, length);
+        return length == word.size() ? id : npos;
+    }
+};
+} // namespace noam
+
+namespace noam::parsers {
+struct dictionary_parser {
+    dictionary const* words;
+    auto parse(state_t st) const noexcept -> result<size_t> {
+        size_t length = 0;
+        size_t id = words->find(st, length);
+        if (id == dictionary::npos) {
+            return {};
+        }
+        return {st.substr(length), id};
+    }
+};
+} // namespace noam::parsers
+
+namespace noam {
+/**
+ * @brief Returns a parser which matches the longest word in `words` that
+ * prefixes the input. The result is the id of the word (its position in the
+ * list the dictionary was built from). The dictionary must outlive the parser.
+ *
+ * ```cpp
+ * noam::dictionary fields(load_field_names());
+ * auto field = noam::parse_dictionary(fields);
+ * ```
+ */
+constexpr auto parse_dictionary(dictionary const& words) noexcept {
+    return parser {parsers::dictionary_parser {&words}};
+}
+} // namespace noam
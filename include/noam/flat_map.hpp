@@ -0,0 +1,349 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace noam {
+/**
+ * @brief What to do when a map being built has the same key more than once
+ */
+enum class duplicate_keys {
+    // Keep the value which came first, as std::map::emplace does
+    keep_first,
+    // Keep the value which came last, as assigning each value in turn does
+    keep_last,
+    // Fail to build the map
+    fail
+};
+
+/**
+ * @brief Sorts a range of key-value pairs by key, and then removes pairs with
+ * duplicate keys, keeping the one chosen by `Duplicates`. Pairs which are
+ * kept are moved to the front of the range.
+ *
+ * @return the end of the pairs which were kept, or std::nullopt if there was
+ * a duplicate key and `Duplicates` is duplicate_keys::fail
+ */
+template <duplicate_keys Duplicates, class It, class Compare>
+std::optional<It> sort_unique_keys(It first, It last, Compare const& compare) {
+    using pair_type = typename std::iterator_traits<It>::value_type;
+    auto by_key = [&](pair_type const& a, pair_type const& b) {
+        return compare(a.first, b.first);
+    };
+    // The sort is stable, so pairs with the same key stay in input order.
+    // Short ranges (which most maps in a document are) are sorted by
+    // insertion, since std::stable_sort allocates a buffer.
+    if (last - first <= 16) {
+        for (It it = first; it != last; ++it) {
+            auto pos = std::upper_bound(first, it, *it, by_key);
+            std::rotate(pos, it, std::next(it));
+        }
+    } else {
+        std::stable_sort(first, last, by_key);
+    }
+    It out = first;
+    for (It it = first; it != last;) {
+        It run_end = std::next(it);
+        while (run_end != last && !by_key(*it, *run_end)) {
+            ++run_end;
+        }
+        if constexpr (Duplicates == duplicate_keys::fail) {
+            if (run_end != std::next(it)) {
+                return std::nullopt;
+            }
+        }
+        It kept = Duplicates == duplicate_keys::keep_last ? std::prev(run_end)
+                                                          : it;
+        if (out != kept) {
+            *out = std::move(*kept);
+        }
+        ++out;
+        it = run_end;
+    }
+    return out;
+}
+
+/**
+ * @brief Tag for constructing a flat_map from pairs that are already sorted,
+ * with no duplicate keys
+ */
+struct sorted_unique_t {
+    explicit sorted_unique_t() = default;
+};
+constexpr sorted_unique_t sorted_unique {};
+
+/**
+ * @brief A map stored as a vector of key-value pairs, sorted by key. Lookups
+ * are a binary search over contiguous memory, and the whole map is a single
+ * allocation, which makes it a good fit for maps which are built once (such
+ * as objects in a parsed document) and then only read.
+ *
+ * Inserting a key moves every pair after it, so build large maps from a
+ * vector of pairs instead of inserting keys one at a time:
+ *
+ * ```cpp
+ * std::vector<std::pair<std::string, int>> pairs {{"b", 2}, {"a", 1}};
+ * noam::flat_map<std::string, int> map(std::move(pairs));
+ * ```
+ *
+ * Keys are stored as non-const values, so they must not be changed through
+ * an iterator.
+ *
+ * @tparam Key the type of the keys
+ * @tparam Value the type of the values
+ * @tparam Compare orders keys (lookups by other types work if it's
+ * transparent, as std::less<> is)
+ */
+template <class Key, class Value, class Compare = std::less<>>
+class flat_map {
+   public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using key_compare = Compare;
+    using container_type = std::vector<value_type>;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+    using size_type = size_t;
+
+   private:
+    container_type pairs;
+    [[no_unique_address]] Compare compare;
+
+    template <class K>
+    auto lower_bound(K const& key) const {
+        return std::partition_point(
+            pairs.begin(),
+            pairs.end(),
+            [&](value_type const& pair) { return compare(pair.first, key); });
+    }
+    template <class K>
+    auto lower_bound(K const& key) {
+        return std::partition_point(
+            pairs.begin(),
+            pairs.end(),
+            [&](value_type const& pair) { return compare(pair.first, key); });
+    }
+    template <class It, class K>
+    bool found(It it, K const& key) const {
+        return it != pairs.end() && !compare(key, it->first);
+    }
+
+   public:
+    flat_map() = default;
+
+    /**
+     * @brief Builds a map from pairs in any order. If a key appears more than
+     * once, the first value is kept.
+     */
+    explicit flat_map(container_type pairs, Compare compare = Compare())
+      : pairs(std::move(pairs))
+      , compare(std::move(compare)) {
+        auto kept = sort_unique_keys<duplicate_keys::keep_first>(
+            this->pairs.begin(),
+            this->pairs.end(),
+            this->compare);
+        this->pairs.erase(*kept, this->pairs.end());
+    }
+
+    /**
+     * @brief Builds a map from pairs which are already sorted by key, with
+     * no duplicate keys. The pairs are used as they are.
+     */
+    flat_map(
+        sorted_unique_t,
+        container_type pairs,
+        Compare compare = Compare()) noexcept
+      : pairs(std::move(pairs))
+      , compare(std::move(compare)) {}
+
+    iterator begin() noexcept { return pairs.begin(); }
+    iterator end() noexcept { return pairs.end(); }
+    const_iterator begin() const noexcept { return pairs.begin(); }
+    const_iterator end() const noexcept { return pairs.end(); }
+
+    size_t size() const noexcept { return pairs.size(); }
+    bool empty() const noexcept { return pairs.empty(); }
+    void clear() noexcept { pairs.clear(); }
+    void reserve(size_t count) { pairs.reserve(count); }
+
+    template <class K>
+    iterator find(K const& key) {
+        auto it = lower_bound(key);
+        return found(it, key) ? it : pairs.end();
+    }
+    template <class K>
+    const_iterator find(K const& key) const {
+        auto it = lower_bound(key);
+        return found(it, key) ? it : pairs.end();
+    }
+    template <class K>
+    bool contains(K const& key) const {
+        return found(lower_bound(key), key);
+    }
+    template <class K>
+    size_t count(K const& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief Returns the value for `key`, throwing std::out_of_range if
+     * there isn't one
+     */
+    template <class K>
+    Value& at(K const& key) {
+        auto it = find(key);
+        if (it == pairs.end()) {
+            throw std::out_of_range("noam::flat_map::at: key not found");
+        }
+        return it->second;
+    }
+    template <class K>
+    Value const& at(K const& key) const {
+        auto it = find(key);
+        if (it == pairs.end()) {
+            throw std::out_of_range("noam::flat_map::at: key not found");
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Inserts a pair, unless the key is already in the map. This is
+     * linear in the size of the map.
+     */
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        auto it = lower_bound(key);
+        if (found(it, key)) {
+            return {it, false};
+        }
+        it = pairs.emplace(
+            it,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        return {it, true};
+    }
+    template <class K, class V>
+    std::pair<iterator, bool> emplace(K&& key, V&& value) {
+        return try_emplace(std::forward<K>(key), std::forward<V>(value));
+    }
+    template <class K>
+    Value& operator[](K&& key) {
+        return try_emplace(std::forward<K>(key)).first->second;
+    }
+
+    /**
+     * @brief The pairs in the map, sorted by key
+     */
+    container_type const& values() const noexcept { return pairs; }
+
+    /**
+     * @brief Moves the pairs out of the map, leaving it empty
+     */
+    container_type extract() && noexcept { return std::move(pairs); }
+
+    friend bool operator==(flat_map const& a, flat_map const& b) {
+        return a.pairs == b.pairs;
+    }
+};
+
+/**
+ * @brief Builds a map from the key-value pairs in `pairs` from `start`
+ * onwards, moving them out of `pairs` and erasing them afterwards.
+ *
+ * - A flat_map is sorted once. If the pairs are all of `pairs`, the vector
+ *   becomes the map's storage without being copied.
+ * - A map with `reserve` (such as std::unordered_map) reserves room for every
+ *   pair before they're inserted, so it never rehashes.
+ * - Any other map (such as std::map) with more than 16 pairs is given them in
+ *   sorted order, each with a hint to insert it at the end, so no insertion
+ *   has to search the tree. Fewer pairs are inserted as they are, since
+ *   sorting them costs more than it saves.
+ *
+ * @tparam Map the type of map to build
+ * @tparam Duplicates what to do if a key appears more than once
+ * @return the map, or std::nullopt if there was a duplicate key and
+ * `Duplicates` is duplicate_keys::fail
+ */
+template <class Map, duplicate_keys Duplicates, class Pair>
+std::optional<Map> build_map(std::vector<Pair>& pairs, size_t start) {
+    auto first = pairs.begin() + start;
+    auto last = pairs.end();
+    // Whatever happens, the pairs are gone once the map is built
+    struct erase_pairs {
+        std::vector<Pair>& pairs;
+        size_t start;
+        ~erase_pairs() { pairs.erase(pairs.begin() + start, pairs.end()); }
+    } erase {pairs, start};
+
+    std::optional<Map> map;
+    if constexpr (requires {
+                      Map(sorted_unique, typename Map::container_type());
+                  }) {
+        using container_type = typename Map::container_type;
+        auto kept = sort_unique_keys<Duplicates>(
+            first,
+            last,
+            typename Map::key_compare());
+        if (!kept) {
+            return map;
+        }
+        if constexpr (std::is_same_v<container_type, std::vector<Pair>>) {
+            if (start == 0) {
+                pairs.erase(*kept, last);
+                map.emplace(sorted_unique, std::move(pairs));
+                return map;
+            }
+        }
+        map.emplace(
+            sorted_unique,
+            container_type(
+                std::make_move_iterator(first),
+                std::make_move_iterator(*kept)));
+    } else {
+        map.emplace();
+        if constexpr (requires(Map& m) { m.reserve(size_t()); }) {
+            map->reserve(last - first);
+        } else if (last - first > 16) {
+            auto kept = sort_unique_keys<Duplicates>(
+                first,
+                last,
+                typename Map::key_compare());
+            if (!kept) {
+                map.reset();
+                return map;
+            }
+            for (auto it = first; it != *kept; ++it) {
+                auto& [key, value] = *it;
+                map->emplace_hint(
+                    map->end(),
+                    std::move(key),
+                    std::move(value));
+            }
+            return map;
+        }
+        for (auto it = first; it != last; ++it) {
+            auto& [key, value] = *it;
+            if constexpr (Duplicates == duplicate_keys::keep_last) {
+                map->insert_or_assign(std::move(key), std::move(value));
+            } else {
+                bool inserted =
+                    map->emplace(std::move(key), std::move(value)).second;
+                if (Duplicates == duplicate_keys::fail && !inserted) {
+                    map.reset();
+                    return map;
+                }
+            }
+        }
+    }
+    return map;
+}
+} // namespace noam
@@ -30,10 +30,37 @@ constexpr parser parse_uint32 = parse_charconv<uint32_t>;
 constexpr parser parse_int64 = parse_charconv<int64_t>;
 constexpr parser parse_uint64 = parse_charconv<uint64_t>;
 
+/**
+ * @brief Parses a base 10 integer without checking for overflow. Only use this
+ * on input which has already been validated.
+ *
+ * @tparam T the integer type to parse
+ */
+template <class T>
+constexpr parser parse_charconv_unchecked {parsers::unchecked_integer<T> {}};
+
 constexpr parser parse_float = parse_charconv<float>;
 constexpr parser parse_double = parse_charconv<double>;
 constexpr parser parse_long_double = parse_charconv<long double>;
 
+/**
+ * @brief Parses a floating point number, accepting the given grammar. See
+ * noam::number_format.
+ *
+ * @tparam T float, double, or long double
+ * @tparam format the grammar to accept
+ */
+template <class T, number_format format = number_format::general>
+constexpr parser parse_floating {parsers::floating_point<T, format> {}};
+
+/**
+ * @brief Parses a number following the JSON grammar as a double
+ *
+ */
+constexpr parser parse_json_double =
+    parse_floating<double, number_format::json>;
+constexpr parser parse_json_float = parse_floating<float, number_format::json>;
+
 template <any_literal... lit>
 constexpr parser literal {parsers::literal<lit...> {}};
 template <class T, any_literal... lit>
@@ -95,6 +122,38 @@ constexpr parser whitespace = match_chs<' ', '\t', '\n', '\r'>;
  */
 constexpr parser ws = whitespace;
 
+/**
+ * @brief Matches one character in the class `cls`, and returns it. Unlike
+ * match_ch, the cost doesn't grow with the size of the class:
+ *
+ * ```cpp
+ * constexpr noam::char_class sign = noam::char_class::of("+-");
+ * auto result = noam::one_of<sign>.parse("-1");
+ * ```
+ *
+ * @tparam cls the class of characters to match
+ */
+template <char_class cls>
+constexpr parser one_of {parsers::one_of<cls> {}};
+
+/**
+ * @brief Matches zero or more characters in the class `cls`, returning them
+ * as a string_view
+ *
+ * @tparam cls the class of characters to match
+ */
+template <char_class cls>
+constexpr parser many_of {parsers::many_of<cls> {}};
+
+/**
+ * @brief Parses a C-style identifier (`[A-Za-z_][A-Za-z0-9_]*`), returning it
+ * as a string_view
+ *
+ */
+constexpr parser identifier {parsers::identifier_parser<
+    char_classes::identifier_start,
+    char_classes::identifier> {}};
+
 /**
  * @brief Parses a line. Newline and carriage return characters are not included
  * in the parsed line.
@@ -118,6 +177,32 @@ constexpr parser parse_bool {parsers::bool_parser {}};
 
 constexpr parser parse_string {parsers::string_parser {}};
 
+/**
+ * @brief Parses a quoted string, decoding any escape sequences. The result is
+ * a noam::cow_string, which refers to the input if the string has no escape
+ * sequences, so that most strings don't need to be allocated.
+ *
+ */
+constexpr parser parse_string_cow {parsers::cow_string_parser {}};
+
+/**
+ * @brief Returns a parser which parses a quoted string, decoding escape
+ * sequences in place. Input given to the parser must lie within `buffer`,
+ * which is overwritten with the decoded string. The result is a string_view
+ * referring to the buffer, so decoding never allocates. A string which fails
+ * to parse is left unchanged, but one with escapes can only be parsed once.
+ *
+ * ```cpp
+ * std::string input = R"("caf\u00e9")";
+ * auto result = noam::parse_string_insitu(input).parse(input);
+ * ```
+ *
+ * @param buffer the mutable buffer holding the input
+ */
+constexpr auto parse_string_insitu(std::span<char> buffer) noexcept {
+    return parser {parsers::insitu_string_parser {buffer}};
+}
+
 /**
  * @brief Parses a section of characters between an opening and closing quote.
  * The section of characters is returned as a string_view. The string itself is
@@ -129,6 +214,21 @@ constexpr parser parse_string_view {parsers::view_parser<'"', '"', '\\'> {}};
 static_assert(
     std::is_empty_v<std::decay_t<decltype(separator<','>)>>,
     "Expected separator to be empty. Are you missing a [[no_unique_address]]?");
+static_assert(
+    literal<"a", "ab", "abc", "b", "c">.parse("abc").get_state() == "bc",
+    "literal broken: the first literal that matches should win");
+static_assert(
+    literal<"abc", "ab", "a", "b", "c">.parse("abx").get_state() == "x",
+    "literal broken");
+static_assert(
+    !literal<"abc", "ab", "ba", "b", "c">.parse("a"),
+    "literal broken");
+static_assert(
+    identifier.parse("_x1 = 2").check_value("_x1"), "identifier broken");
+static_assert(!identifier.parse("1x"), "identifier broken");
+static_assert(
+    many_of<char_classes::hex_digit>.parse("c0ffee!").check_value("c0ffee"),
+    "many_of broken");
 static_assert(
     parse_string_view.parse(R"("")").check_value(""),
     "parse_string_view broken");
@@ -142,5 +242,35 @@ static_assert(
     parse_string_view.parse(R"("hello\" world")")
         .check_value(R"(hello\" world)"),
     "parse_string_view broken");
+static_assert(
+    parse_string_view.parse(R"("hello\\" world")").check_value(R"(hello\\)"),
+    "parse_string_view broken: an escaped escape shouldn't escape the quote");
+static_assert(
+    parse_string_view.parse(R"("a\\\"b")").check_value(R"(a\\\"b)"),
+    "parse_string_view broken");
+static_assert(
+    !parse_string_view.parse(R"("unterminated\")"),
+    "parse_string_view broken");
+
+static_assert(
+    *first_set_of<decltype(literal<"null", "true", 'x'>)>()
+        == char_class::of("ntx"),
+    "A literal's FIRST set is the first byte of each literal");
+static_assert(
+    !first_set_of<decltype(literal<"null", any_literal<empty_literal> {}>)>(),
+    "The empty literal matches any input, so there's no FIRST set");
+static_assert(
+    *first_set_of<decltype(parse_string_view)>() == char_class::of("\""),
+    "parse_string_view starts with a quote");
+static_assert(
+    first_set_of<decltype(parse_uint)>() == char_classes::digit,
+    "Unsigned integers start with a digit");
+static_assert(
+    first_set_of<decltype(parse_json_double)>()
+        == (char_classes::digit | char_class::of("-")),
+    "JSON numbers start with a digit or '-'");
+static_assert(
+    !first_set_of<decltype(whitespace)>(),
+    "whitespace can match empty input, so it has no FIRST set");
 
 } // namespace noam
@@ -0,0 +1,110 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <noam/state.hpp>
+#include <noam/util/simd.hpp>
+#include <string_view>
+#include <vector>
+
+namespace noam {
+/**
+ * @brief A line and column within a document. Both are 1-based, and the
+ * column is measured in bytes.
+ *
+ */
+struct source_location {
+    size_t line = 1;
+    size_t column = 1;
+
+    constexpr bool operator==(source_location const&) const noexcept = default;
+};
+
+/**
+ * @brief Maps positions within a document to line and column numbers.
+ *
+ * Parsers only track the remaining input, so a position (such as the state of
+ * a failed parse) doesn't know which line it's on. A line_index scans the
+ * document for newlines the first time it's queried, and then resolves each
+ * position with a binary search, so reporting many errors against the same
+ * document doesn't rescan it each time.
+ *
+ * ```cpp
+ * noam::line_index index(input);
+ * auto [line, column] = index.locate(failed_state.data());
+ * ```
+ *
+ * The document must remain alive (and unmodified) for as long as the index is
+ * used.
+ *
+ */
+class line_index {
+    state_t document;
+    // Offset of each '\n' in the document. Built on the first query.
+    std::vector<size_t> newlines;
+    bool built = false;
+
+    void build() {
+        char const* begin = document.begin();
+        simd::for_each(begin, document.end(), '\n', [&](char const* pos) {
+            newlines.push_back(pos - begin);
+        });
+        built = true;
+    }
+
+   public:
+    line_index() = default;
+    explicit line_index(state_t document) noexcept
+      : document(document) {}
+
+    /**
+     * @brief Returns the document being indexed
+     */
+    state_t get_document() const noexcept { return document; }
+
+    /**
+     * @brief Returns the line and column of `pos`, which must point into the
+     * document (or to its end). A newline is considered part of the line it
+     * ends.
+     */
+    source_location locate(char const* pos) {
+        if (!built) {
+            build();
+        }
+        size_t offset = pos - document.begin();
+        // Number of newlines strictly before pos
+        size_t line = std::lower_bound(newlines.begin(), newlines.end(), offset)
+                    - newlines.begin();
+        size_t line_start = line == 0 ? 0 : newlines[line - 1] + 1;
+        return {line + 1, offset - line_start + 1};
+    }
+    source_location locate(state_t st) { return locate(st.data()); }
+
+    /**
+     * @brief Returns the number of lines in the document. A trailing newline
+     * begins a final, empty line.
+     */
+    size_t line_count() {
+        if (!built) {
+            build();
+        }
+        return newlines.size() + 1;
+    }
+
+    /**
+     * @brief Returns the contents of the given (1-based) line, without its
+     * newline. Useful for printing the context of an error.
+     */
+    std::string_view line(size_t line) {
+        if (!built) {
+            build();
+        }
+        if (line == 0 || line > newlines.size() + 1) {
+            return {};
+        }
+        size_t start = line == 1 ? 0 : newlines[line - 2] + 1;
+        size_t end = line > newlines.size() ? document.size()
+                                            : newlines[line - 1];
+        return std::string_view(document.data() + start, end - start);
+    }
+};
+} // namespace noam
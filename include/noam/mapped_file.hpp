@@ -0,0 +1,250 @@
+#pragma once
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <noam/state.hpp>
+#include <noam/type_traits.hpp>
+#include <system_error>
+#include <utility>
+
+// Files are memory-mapped where POSIX mmap is available, unless this is
+// defined to 0, in which case they're read into memory
+#ifndef NOAM_HAS_MMAP
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define NOAM_HAS_MMAP 1
+#else
+#define NOAM_HAS_MMAP 0
+#endif
+#endif
+
+#if NOAM_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace noam {
+/**
+ * @brief A read-only view of a file's contents, which can be used directly as
+ * the input to a parser. On POSIX systems regular files are memory-mapped
+ * (with sequential-access and huge page hints). Other files (such as pipes,
+ * devices, and files in /proc, which don't report their size) are read into
+ * memory, as every file is on other systems.
+ *
+ * Views obtained from the file (including any string_views produced by
+ * parsing it) are valid for as long as the mapped_file is alive.
+ *
+ */
+class mapped_file {
+    // An empty file still produces a non-null (but empty) state, so that
+    // parsers don't treat it as a failed result
+    char const* _data = "";
+    size_t _size = 0;
+#if NOAM_HAS_MMAP
+    void* _mapping = nullptr;
+#endif
+    std::unique_ptr<char[]> _buffer;
+
+    [[noreturn]] static void fail(char const* what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+#if NOAM_HAS_MMAP
+    /**
+     * @brief Reads from `fd` until the end of the file, for files which can't
+     * be mapped. The buffer doubles in size whenever it fills up.
+     */
+    void read_all(int fd) {
+        size_t capacity = 0;
+        size_t size = 0;
+        for (;;) {
+            if (size == capacity) {
+                capacity = capacity ? capacity * 2 : 4096;
+                auto larger = std::make_unique<char[]>(capacity);
+                if (size > 0) {
+                    std::memcpy(larger.get(), _buffer.get(), size);
+                }
+                _buffer = std::move(larger);
+            }
+            ssize_t count = ::read(fd, _buffer.get() + size, capacity - size);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                int err = errno;
+                ::close(fd);
+                errno = err;
+                fail("noam::mapped_file: unable to read file");
+            }
+            if (count == 0) {
+                break;
+            }
+            size += count;
+        }
+        if (size > 0) {
+            _data = _buffer.get();
+            _size = size;
+        }
+    }
+#endif
+
+   public:
+    /**
+     * @brief Constructs an empty mapped_file
+     *
+     */
+    mapped_file() = default;
+
+    /**
+     * @brief Maps the file at the given path. Throws std::system_error if the
+     * file can't be opened or mapped.
+     *
+     * @param path the path of the file to map
+     */
+    explicit mapped_file(std::filesystem::path const& path) {
+#if NOAM_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            fail("noam::mapped_file: unable to open file");
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            int err = errno;
+            ::close(fd);
+            errno = err;
+            fail("noam::mapped_file: unable to stat file");
+        }
+        // Only regular files report their real size, and even then files in
+        // /proc report a size of 0, so anything else is read instead (which
+        // also covers files which really are empty)
+        if (!S_ISREG(info.st_mode) || info.st_size == 0) {
+            read_all(fd);
+            ::close(fd);
+            return;
+        }
+        if (uintmax_t(info.st_size) > SIZE_MAX) {
+            ::close(fd);
+            errno = EFBIG;
+            fail("noam::mapped_file: file too large to map");
+        }
+        size_t size = info.st_size;
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            int err = errno;
+            ::close(fd);
+            errno = err;
+            fail("noam::mapped_file: unable to map file");
+        }
+        // These are hints, so failures are ignored. The advice values aren't
+        // flags, so they have to be given in separate calls
+        ::madvise(mapping, size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+        ::madvise(mapping, size, MADV_HUGEPAGE);
+#endif
+        _mapping = mapping;
+        _data = static_cast<char const*>(mapping);
+        _size = size;
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            fail("noam::mapped_file: unable to open file");
+        }
+        auto end = file.tellg();
+        if (end < 0) {
+            errno = EIO;
+            fail("noam::mapped_file: unable to get the size of file");
+        }
+        size_t size = size_t(end);
+        if (size > 0) {
+            _buffer = std::make_unique<char[]>(size);
+            file.seekg(0);
+            file.read(_buffer.get(), std::streamsize(size));
+            if (size_t(file.gcount()) != size) {
+                errno = EIO;
+                fail("noam::mapped_file: unable to read file");
+            }
+            _data = _buffer.get();
+            _size = size;
+        }
+#endif
+    }
+
+    mapped_file(mapped_file&& other) noexcept
+      : _data(std::exchange(other._data, ""))
+      , _size(std::exchange(other._size, 0))
+#if NOAM_HAS_MMAP
+      , _mapping(std::exchange(other._mapping, nullptr))
+#endif
+      , _buffer(std::move(other._buffer)) {}
+    mapped_file& operator=(mapped_file other) noexcept {
+        swap(other);
+        return *this;
+    }
+    ~mapped_file() {
+#if NOAM_HAS_MMAP
+        if (_mapping) {
+            ::munmap(_mapping, _size);
+        }
+#endif
+    }
+
+    void swap(mapped_file& other) noexcept {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+#if NOAM_HAS_MMAP
+        std::swap(_mapping, other._mapping);
+#endif
+        std::swap(_buffer, other._buffer);
+    }
+
+    char const* data() const noexcept { return _data; }
+    size_t size() const noexcept { return _size; }
+    bool empty() const noexcept { return _size == 0; }
+
+    /**
+     * @brief Returns the contents of the file as a state, so that it can be
+     * given to a parser
+     *
+     * @return state_t the contents of the file
+     */
+    state_t state() const noexcept { return state_t(_data, _size); }
+    operator state_t() const noexcept { return state(); }
+};
+
+/**
+ * @brief The result of noam::parse_file. Holds the mapped file alongside the
+ * parse result, so that any views into the file remain valid.
+ *
+ * @tparam Result the result type of the parser
+ */
+template <class Result>
+struct parsed_file {
+    mapped_file file;
+    Result result;
+};
+
+/**
+ * @brief Maps the file at the given path and parses its contents. Throws
+ * std::system_error if the file can't be mapped.
+ *
+ * ```cpp
+ * auto [file, result] = noam::parse_file("data.csv", parser);
+ * ```
+ *
+ * @param path the file to parse
+ * @param parser the parser to apply to the contents of the file
+ */
+template <any_parser Parser>
+auto parse_file(std::filesystem::path const& path, Parser const& parser)
+    -> parsed_file<parser_result_t<Parser>> {
+    mapped_file file(path);
+    auto result = parser.parse(file.state());
+    return {std::move(file), std::move(result)};
+}
+} // namespace noam
@@ -0,0 +1,215 @@
+#pragma once
+#include <memory>
+#include <noam/parser.hpp>
+#include <noam/result_types.hpp>
+#include <noam/type_traits.hpp>
+#include <noam/util/first_set.hpp>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace noam {
+/**
+ * @brief Holds the results of memoized parsers (see noam::memo) for a single
+ * parse. Creating a memo_table installs it for the current thread, and the
+ * previously installed table is restored when it's destroyed, so a table is
+ * normally a local variable wrapping one parse:
+ *
+ * ```cpp
+ * noam::memo_table memo;
+ * auto result = config_file.parse(input);
+ * ```
+ *
+ * Results are keyed by the position in the input and the parser, so the
+ * input must not change while the table is installed. Tables are destroyed in
+ * the reverse of the order they were created, which is always the case for
+ * local variables.
+ *
+ */
+class memo_table {
+    struct table_base {
+        virtual ~table_base() = default;
+        virtual size_t size() const noexcept = 0;
+    };
+
+   public:
+    /**
+     * @brief The memoized results of one parser
+     *
+     * @tparam Value the type of value the parser produces
+     */
+    template <class Value>
+    struct entry {
+        enum status_t : char { in_progress, failed, matched };
+        status_t status = in_progress;
+        // The end of the input when the result was stored. A lookup with a
+        // different end is treated as a miss.
+        char const* input_end = nullptr;
+        // Where the parser stopped, if it matched
+        char const* stop = nullptr;
+        std::optional<Value> value;
+    };
+    template <class Value>
+    struct table : table_base {
+        std::unordered_map<char const*, entry<Value>> entries;
+        size_t size() const noexcept override { return entries.size(); }
+    };
+
+   private:
+    std::unordered_map<void const*, std::unique_ptr<table_base>> tables;
+    memo_table* previous;
+
+    static memo_table*& installed() noexcept {
+        thread_local memo_table* table = nullptr;
+        return table;
+    }
+
+   public:
+    memo_table() noexcept
+      : previous(installed()) {
+        installed() = this;
+    }
+    memo_table(memo_table const&) = delete;
+    memo_table& operator=(memo_table const&) = delete;
+    ~memo_table() { installed() = previous; }
+
+    /**
+     * @brief Returns the table installed for the current thread, or nullptr
+     * if there isn't one
+     */
+    static memo_table* current() noexcept { return installed(); }
+
+    /**
+     * @brief Returns the results stored for the parser identified by `id`
+     */
+    template <class Value>
+    table<Value>& results_for(void const* id) {
+        auto& slot = tables[id];
+        if (!slot) {
+            slot = std::make_unique<table<Value>>();
+        }
+        return static_cast<table<Value>&>(*slot);
+    }
+
+    /**
+     * @brief The number of results stored, across all parsers
+     */
+    size_t size() const noexcept {
+        size_t total = 0;
+        for (auto const& [id, table] : tables) {
+            total += table->size();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Discards every stored result
+     */
+    void clear() noexcept { tables.clear(); }
+};
+} // namespace noam
+
+namespace noam::parsers {
+/**
+ * @brief Memoizes `parser`, using the memo_table installed for the current
+ * thread. Parsers are identified by their type (and `Tag`), so the result
+ * stored for one memo<Tag, Parser> is used by any other.
+ *
+ * A position which is still being parsed is treated as a failure, so a
+ * left-recursive rule fails instead of recursing forever.
+ */
+template <class Tag, class Parser>
+struct memo {
+    [[no_unique_address]] Parser parser;
+    using value_type = parser_value_t<Parser>;
+    using result_type =
+        get_result_t<value_type, parser_always_good_v<Parser>>;
+    using entry_type = memo_table::entry<value_type>;
+
+    // Only the address of this is used, to identify the parser
+    constexpr static char id = 0;
+
+    constexpr static auto first_set() noexcept {
+        return first_set_of<Parser>();
+    }
+
+    auto parse(state_t st) const -> result_type {
+        memo_table* memo = memo_table::current();
+        if (!memo) {
+            auto r = parser.parse(st);
+            return from_result(r);
+        }
+        auto& entries = memo->results_for<value_type>(&id).entries;
+        // Entries are never erased, and references to them stay valid when
+        // the map grows, so the entry can be filled in after parsing
+        auto [it, inserted] = entries.try_emplace(st.data());
+        entry_type& entry = it->second;
+        if (!inserted && entry.input_end == st.end()) {
+            if (entry.status == entry_type::matched) {
+                return {state_t(entry.stop, st.end()), *entry.value};
+            }
+            // A parser that always succeeds has no failure to return, so a
+            // position still in progress is parsed again
+            if constexpr (!parser_always_good_v<Parser>) {
+                return {};
+            }
+        }
+        entry = entry_type {
+            entry_type::in_progress,
+            st.end(),
+            nullptr,
+            std::nullopt};
+        auto r = parser.parse(st);
+        if (r) {
+            entry.status = entry_type::matched;
+            entry.stop = r.get_state().data();
+            entry.value.emplace(r.get_value());
+        } else {
+            entry.status = entry_type::failed;
+        }
+        return from_result(r);
+    }
+
+   private:
+    template <class Result>
+    static result_type from_result(Result& r) {
+        if constexpr (parser_always_good_v<Parser>) {
+            return {r.get_state(), std::move(r).get_value()};
+        } else {
+            if (!r) {
+                return {};
+            }
+            return {r.get_state(), std::move(r).get_value()};
+        }
+    }
+};
+} // namespace noam::parsers
+
+namespace noam {
+/**
+ * @brief Memoizes a parser, so that parsing the same position twice (which
+ * happens when alternatives of `either` share a prefix) reuses the first
+ * result. With memoization, a grammar that would backtrack exponentially is
+ * parsed in linear time, at the cost of storing a result for each position.
+ *
+ * Results are stored in the memo_table installed for the current thread.
+ * Without one, the parser is run normally. Values are copied out of the
+ * table, so memoize rules whose values are cheap to copy.
+ *
+ * Parsers are identified by type. Two memoized parsers of the same type which
+ * behave differently (such as two require_prefix parsers) need distinct tags:
+ *
+ * ```cpp
+ * auto a = noam::memo<struct prefix_a>(noam::require_prefix("a"));
+ * auto b = noam::memo<struct prefix_b>(noam::require_prefix("b"));
+ * ```
+ *
+ * @tparam Tag distinguishes parsers of the same type
+ * @param p the parser to memoize
+ */
+template <class Tag = void, class Parser>
+constexpr auto memo(Parser&& p) {
+    auto base = parser {std::forward<Parser>(p)};
+    return parser {parsers::memo<Tag, decltype(base)> {std::move(base)}};
+}
+} // namespace noam
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstring>
+#include <memory>
+#include <noam/state.hpp>
+#include <string_view>
+
+namespace noam {
+/**
+ * @brief The number of readable bytes guaranteed to follow the end of a
+ * padded_state
+ *
+ */
+constexpr size_t input_padding = 64;
+
+/**
+ * @brief A state which guarantees that at least noam::input_padding bytes
+ * past its end can be read. Intrinsic parsers have overloads for
+ * padded_state which read whole words or SIMD blocks at a time without
+ * checking the end of the input after every byte.
+ *
+ * The padding bytes are only ever read, never parsed: results are still
+ * bounded by the end of the state. Results are returned as an ordinary
+ * state_t, so the padding only applies to the parser it's given to directly,
+ * not to parsers nested inside combinators.
+ *
+ * Use noam::padded_buffer to obtain padded input, or construct a padded_state
+ * directly from memory that's known to be padded.
+ *
+ */
+struct padded_state : state_t {
+    padded_state() = default;
+    /**
+     * @brief Constructs a padded_state. At least noam::input_padding bytes
+     * past `end` must be readable.
+     */
+    constexpr explicit padded_state(char const* begin, char const* end) noexcept
+      : state_t(begin, end) {}
+};
+
+/**
+ * @brief An owned copy of some input, followed by noam::input_padding zero
+ * bytes, so that it can be parsed as a padded_state
+ *
+ */
+class padded_buffer {
+    std::unique_ptr<char[]> _data;
+    size_t _size = 0;
+
+   public:
+    padded_buffer()
+      : padded_buffer(size_t(0)) {}
+    explicit padded_buffer(size_t size)
+      : _data(new char[size + input_padding] {})
+      , _size(size) {}
+    explicit padded_buffer(std::string_view input)
+      : padded_buffer(input.size()) {
+        std::memcpy(_data.get(), input.data(), input.size());
+    }
+
+    char* data() noexcept { return _data.get(); }
+    char const* data() const noexcept { return _data.get(); }
+    size_t size() const noexcept { return _size; }
+
+    /**
+     * @brief Returns the contents of the buffer as a padded_state
+     */
+    padded_state state() const noexcept {
+        return padded_state(_data.get(), _data.get() + _size);
+    }
+    operator padded_state() const noexcept { return state(); }
+};
+} // namespace noam
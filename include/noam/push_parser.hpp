@@ -0,0 +1,134 @@
+#pragma once
+#include <noam/coupling/push_promise.hpp>
+#include <noam/result_types.hpp>
+#include <string_view>
+#include <utility>
+
+namespace noam {
+/**
+ * @brief A push-mode (incremental) coroutine parser. Input is given to the
+ * parser in fragments via feed(), and the parser is suspended whenever it
+ * runs out of input. Resuming it with the next fragment continues from the
+ * parser that was waiting, so input that has already been consumed is never
+ * parsed again.
+ *
+ * A push-mode parser is written as a coroutine returning push_parser<T>, and
+ * can co_await any noam parser:
+ *
+ * ```cpp
+ * noam::push_parser<long> sum_ints() {
+ *     long sum = co_await noam::parse_long;
+ *     noam::parser next = noam::try_parse(noam::comma_separator >> noam::parse_long);
+ *     while (std::optional value = co_await next) {
+ *         sum += *value;
+ *     }
+ *     co_return sum;
+ * }
+ *
+ * auto p = sum_ints();
+ * p.feed("12, 3");  // push_status::need_more
+ * p.feed("4, 5");   // push_status::need_more
+ * p.finish();       // push_status::done, p.get_value() == 51
+ * ```
+ *
+ * Consumed input is discarded when more input is fed to the parser, so any
+ * value which refers to the input (such as a std::string_view) is only valid
+ * until the next call to feed().
+ *
+ * @tparam T the value produced by the parser
+ */
+template <class T>
+class push_parser {
+   public:
+    using promise_type = push_promise<T>;
+    using handle_t = std::coroutine_handle<promise_type>;
+
+   private:
+    handle_t handle;
+
+    push_input& input() const noexcept { return handle.promise().input; }
+
+    push_status run() {
+        push_input& in = input();
+        if (in.pending) {
+            if (!in.retry(in.pending)) {
+                return status();
+            }
+            in.pending = nullptr;
+        }
+        handle.resume();
+        return status();
+    }
+
+   public:
+    explicit push_parser(handle_t handle) noexcept
+      : handle(handle) {}
+    push_parser(push_parser&& other) noexcept
+      : handle(std::exchange(other.handle, nullptr)) {}
+    push_parser& operator=(push_parser other) noexcept {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+    ~push_parser() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    /**
+     * @brief Returns the current status of the parser
+     */
+    push_status status() const noexcept {
+        if (input().failed) {
+            return push_status::failed;
+        }
+        if (handle.done()) {
+            return handle.promise().value ? push_status::done
+                                          : push_status::failed;
+        }
+        return push_status::need_more;
+    }
+
+    /**
+     * @brief Appends the fragment to the input, and runs the parser until it
+     * needs more input, completes, or fails.
+     *
+     * @param fragment the next fragment of input
+     */
+    push_status feed(std::string_view fragment) {
+        if (status() != push_status::need_more) {
+            return status();
+        }
+        push_input& in = input();
+        in.buffer.erase(0, in.consumed);
+        in.consumed = 0;
+        in.buffer.append(fragment);
+        return run();
+    }
+
+    /**
+     * @brief Marks the end of the input, and runs the parser until it
+     * completes or fails.
+     */
+    push_status finish() {
+        if (status() != push_status::need_more) {
+            return status();
+        }
+        input().finished = true;
+        return run();
+    }
+
+    /**
+     * @brief Returns the input that has been received but not yet consumed
+     */
+    state_t remaining() const noexcept { return input().remaining(); }
+
+    /**
+     * @brief Gets the value produced by the parser. Only valid if status()
+     * is push_status::done.
+     */
+    T& get_value() & noexcept { return *handle.promise().value; }
+    T const& get_value() const& noexcept { return *handle.promise().value; }
+    T&& get_value() && noexcept { return std::move(*handle.promise().value); }
+};
+} // namespace noam
@@ -0,0 +1,66 @@
+#pragma once
+#include <noam/intrinsics.hpp>
+#include <noam/result_types.hpp>
+#include <noam/state.hpp>
+#include <noam/util/simd.hpp>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace noam {
+/**
+ * @brief Splits the input into lines in a single pass, appending each line to
+ * `lines`. Lines are split the same way as noam::parse_line: a trailing
+ * '\r' is removed from lines ending in "\r\n", and a final newline doesn't
+ * begin another (empty) line.
+ *
+ * The lines refer to the input, so they're only valid as long as it is.
+ *
+ * @param input the input to split
+ * @param lines the vector to append lines to
+ * @return size_t the number of lines appended
+ */
+inline size_t split_lines(state_t input, std::vector<std::string_view>& lines) {
+    size_t initial_count = lines.size();
+    char const* line_begin = input.begin();
+    char const* end = input.end();
+    while (line_begin < end) {
+        char const* newline = simd::find(line_begin, end, '\n');
+        lines.push_back(
+            parsers::line_parser::split_at(line_begin, newline, end)
+                .get_value());
+        line_begin = newline == end ? end : newline + 1;
+    }
+    return lines.size() - initial_count;
+}
+
+/**
+ * @brief Splits the input into lines in a single pass, filling `lines` with
+ * at most lines.size() of them. Lines are split the same way as
+ * noam::parse_line.
+ *
+ * If there are more lines than fit, the result's state holds the input that
+ * wasn't split, so that the caller can process a batch of lines and call
+ * split_lines again with the rest.
+ *
+ * @param input the input to split
+ * @param lines the span to fill
+ * @return pure_result<size_t> the remaining input, and the number of lines
+ * written to `lines`
+ */
+inline pure_result<size_t> split_lines(
+    state_t input,
+    std::span<std::string_view> lines) {
+    size_t count = 0;
+    char const* line_begin = input.begin();
+    char const* end = input.end();
+    while (count < lines.size() && line_begin < end) {
+        char const* newline = simd::find(line_begin, end, '\n');
+        lines[count++] =
+            parsers::line_parser::split_at(line_begin, newline, end)
+                .get_value();
+        line_begin = newline == end ? end : newline + 1;
+    }
+    return {state_t(line_begin, end), count};
+}
+} // namespace noam
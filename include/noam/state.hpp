@@ -1,8 +1,10 @@
 #pragma once
 #include <compare>
 #include <cstddef>
+#include <cstring>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 
 namespace noam {
@@ -12,6 +14,10 @@ struct state {
             c_string++;
         return c_string;
     }
+    // At runtime, comparisons at least this long use memcmp (which compares
+    // 16 or 32 bytes at a time). Shorter ones are faster as a loop.
+    constexpr static intptr_t memcmp_threshold = 4;
+
     char const* _begin = nullptr;
     char const* _end = nullptr;
 
@@ -126,6 +132,9 @@ struct state {
         if (size() < prefix_len) {
             return false;
         }
+        if (!std::is_constant_evaluated() && prefix_len >= memcmp_threshold) {
+            return std::memcmp(_begin, prefix._begin, prefix_len) == 0;
+        }
         for (intptr_t i = 0; i < prefix_len; i++) {
             if (prefix._begin[i] != _begin[i]) {
                 return false;
@@ -139,6 +148,9 @@ struct state {
         if (size() < Len) {
             return false;
         }
+        if (!std::is_constant_evaluated()) {
+            return Len == 0 || std::memcmp(_begin, prefix, Len) == 0;
+        }
         for (size_t i = 0; i < Len; i++) {
             if (prefix[i] != _begin[i]) {
                 return false;
@@ -166,6 +178,10 @@ struct state {
         const auto other_length = other.size();
         if (other_length != size())
             return false;
+        if (!std::is_constant_evaluated()
+            && other_length >= memcmp_threshold) {
+            return std::memcmp(_begin, other._begin, other_length) == 0;
+        }
         for (intptr_t i = 0; i < other_length; i++) {
             if (other._begin[i] != _begin[i])
                 return false;
@@ -190,8 +206,15 @@ struct state {
         if (s2 < 0)
             s2 = 0;
         auto len = s1 < s2 ? s1 : s2;
+        if (!std::is_constant_evaluated() && len >= memcmp_threshold) {
+            int order = std::memcmp(_begin, other._begin, len);
+            return order == 0 ? s1 <=> s2 : order <=> 0;
+        }
+        // Bytes are compared as unsigned char, matching memcmp and
+        // std::string_view
         for (intptr_t i = 0; i < len; i++) {
-            std::strong_ordering order = _begin[i] <=> other._begin[i];
+            std::strong_ordering order = (unsigned char)_begin[i]
+                                     <=> (unsigned char)other._begin[i];
             if (order == std::strong_ordering::equivalent)
                 continue;
             else
@@ -258,6 +281,11 @@ static_assert(""_st == ""_st, "Empty states must be lexically equivilant");
 static_assert("uwu"_st != "owo"_st, "Differing states must not be equivilant");
 static_assert("a"_st < "b"_st, "Lexical ordering of state is broken");
 static_assert("a"_st <= "b"_st, "Lexical ordering of state is broken");
+static_assert("ab"_st < "b"_st, "Lexical ordering of state is broken");
+static_assert("a"_st < "ab"_st, "Lexical ordering of state is broken");
+static_assert(
+    "a"_st < "\xff"_st,
+    "Bytes should be ordered as unsigned char, like memcmp");
 static_assert(
     ""_st < "a"_st,
     "Empty states must be strictly less than nonempty states");
@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace noam {
+/**
+ * @brief A vector with a fixed capacity, whose elements are stored inside it
+ * rather than on the heap. It has the interface of std::vector, except that
+ * it can't grow past `Capacity`: pushing onto a full static_vector throws
+ * std::length_error.
+ *
+ * Elements are constructed only when they're added, so the element type
+ * doesn't need to be default-constructible.
+ *
+ * @tparam T the type of the elements
+ * @tparam Capacity the most elements it can hold
+ */
+template <class T, size_t Capacity>
+class static_vector {
+    // Elements live in a union, so they aren't constructed with the vector
+    union storage {
+        storage() noexcept {}
+        ~storage() {}
+        T values[Capacity == 0 ? 1 : Capacity];
+    };
+    storage elems;
+    size_t count = 0;
+
+    void check_room() const {
+        if (count == Capacity) {
+            throw std::length_error("noam::static_vector is full");
+        }
+    }
+
+   public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using iterator = T*;
+    using const_iterator = T const*;
+
+    static_vector() noexcept = default;
+    static_vector(static_vector const& other) {
+        for (auto const& value : other) {
+            emplace_back(value);
+        }
+    }
+    static_vector(static_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        for (auto& value : other) {
+            emplace_back(std::move(value));
+        }
+    }
+    static_vector(std::initializer_list<T> values) {
+        for (auto const& value : values) {
+            push_back(value);
+        }
+    }
+    static_vector& operator=(static_vector const& other) {
+        if (this != &other) {
+            clear();
+            for (auto const& value : other) {
+                emplace_back(value);
+            }
+        }
+        return *this;
+    }
+    static_vector& operator=(static_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            for (auto& value : other) {
+                emplace_back(std::move(value));
+            }
+        }
+        return *this;
+    }
+    ~static_vector() { clear(); }
+
+    T* data() noexcept { return elems.values; }
+    T const* data() const noexcept { return elems.values; }
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + count; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + count; }
+
+    size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    constexpr static size_t capacity() noexcept { return Capacity; }
+    constexpr static size_t max_size() noexcept { return Capacity; }
+    bool full() const noexcept { return count == Capacity; }
+
+    T& operator[](size_t i) noexcept { return data()[i]; }
+    T const& operator[](size_t i) const noexcept { return data()[i]; }
+    T& front() noexcept { return data()[0]; }
+    T const& front() const noexcept { return data()[0]; }
+    T& back() noexcept { return data()[count - 1]; }
+    T const& back() const noexcept { return data()[count - 1]; }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        check_room();
+        T* value = std::construct_at(end(), std::forward<Args>(args)...);
+        count++;
+        return *value;
+    }
+    void push_back(T const& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    void pop_back() noexcept {
+        count--;
+        std::destroy_at(end());
+    }
+    void clear() noexcept {
+        std::destroy(begin(), end());
+        count = 0;
+    }
+
+    friend bool operator==(static_vector const& a, static_vector const& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+};
+} // namespace noam
@@ -0,0 +1,240 @@
+#pragma once
+#include <cerrno>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <noam/state.hpp>
+#include <noam/type_traits.hpp>
+#include <noam/util/partial_input.hpp>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#define NOAM_HAS_FD_SOURCE 1
+#else
+#define NOAM_HAS_FD_SOURCE 0
+#endif
+
+namespace noam {
+/**
+ * @brief The default size of the buffer used by noam::for_each_record
+ *
+ */
+constexpr size_t default_stream_buffer_size = size_t(1) << 16;
+
+enum class stream_status {
+    // All input was parsed (or the callback asked to stop)
+    ok,
+    // A record couldn't be parsed, or the parser made no progress
+    parse_error,
+    // A single record didn't fit in the buffer
+    record_too_large,
+    // Reading from the source failed
+    io_error
+};
+
+/**
+ * @brief The outcome of streaming a source through a record parser
+ *
+ */
+struct stream_result {
+    stream_status status = stream_status::ok;
+    // The number of records passed to the callback
+    size_t records = 0;
+    // The number of bytes consumed by successfully parsed records
+    size_t bytes = 0;
+
+    constexpr explicit operator bool() const noexcept {
+        return status == stream_status::ok;
+    }
+};
+
+/**
+ * @brief A source of input for noam::for_each_record. `read(buffer, count)`
+ * reads up to count bytes into buffer, returning the number of bytes read, 0
+ * at end of input, or a negative value on error.
+ *
+ */
+template <class Source>
+concept stream_source = requires(Source& source, char* buffer, size_t count) {
+    { source.read(buffer, count) } -> std::same_as<ptrdiff_t>;
+};
+
+#if NOAM_HAS_FD_SOURCE
+/**
+ * @brief Reads from a file descriptor. The file descriptor isn't owned.
+ *
+ */
+struct fd_source {
+    int fd = -1;
+    /**
+     * @brief Reads up to `count` bytes into `buffer`. Returns the number of
+     * bytes read, 0 at end of input, or -1 on error.
+     */
+    ptrdiff_t read(char* buffer, size_t count) const noexcept {
+        for (;;) {
+            ssize_t n = ::read(fd, buffer, count);
+            if (n >= 0 || errno != EINTR) {
+                return n;
+            }
+        }
+    }
+};
+#endif
+
+/**
+ * @brief Reads from a std::istream. The stream isn't owned.
+ *
+ */
+struct istream_source {
+    std::istream* stream = nullptr;
+    /**
+     * @brief Reads up to `count` bytes into `buffer`. Returns the number of
+     * bytes read, 0 at end of input, or -1 on error.
+     */
+    ptrdiff_t read(char* buffer, size_t count) const {
+        stream->read(buffer, count);
+        if (stream->bad()) {
+            return -1;
+        }
+        return stream->gcount();
+    }
+};
+
+/**
+ * @brief Repeatedly reads from `source` into a fixed-size buffer, applying
+ * `parser` to extract one record at a time and passing each record's value to
+ * `func`. Memory use is bounded by `buffer_size`, regardless of how large the
+ * input is.
+ *
+ * Records are parsed with a partial_input installed. Until the source is
+ * exhausted, a record is only accepted once it's followed by more input in the
+ * buffer, and the parser didn't reach the end of the buffer. A record that
+ * runs up to the end of the buffer might be incomplete, so it's carried over
+ * to the front of the buffer, and parsed again once the buffer has been
+ * refilled. A record that fails to parse without reaching the end of the
+ * buffer can't be fixed by more input, so it's reported as a parse_error
+ * straight away.
+ *
+ * Values passed to `func` which refer to the input (such as the
+ * std::string_view produced by parse_line) point into the buffer, and are
+ * only valid until `func` returns.
+ *
+ * If `func` returns a bool, returning false stops the stream early.
+ *
+ * @param source the source to read from (e.g. fd_source or istream_source)
+ * @param parser the parser used to extract a record
+ * @param func the function to invoke on each record's value
+ * @param buffer_size the size of the buffer. Must be larger than any record.
+ * @return stream_result the status, and the number of records parsed
+ */
+template <stream_source Source, any_parser Parser, class Func>
+stream_result for_each_record(
+    Source&& source,
+    Parser const& parser,
+    Func&& func,
+    size_t buffer_size = default_stream_buffer_size) {
+    auto buffer = std::make_unique<char[]>(buffer_size);
+    char* const buffer_begin = buffer.get();
+    char* end = buffer_begin;
+    bool eof = false;
+    stream_result out;
+    state_t st(buffer_begin, end);
+    for (;;) {
+        while (!(eof && st.empty())) {
+            bool reached_end = false;
+            auto result = [&] {
+                partial_input partial;
+                auto r = parser.parse(st);
+                reached_end = partial.reached_end();
+                return r;
+            }();
+            bool complete = result
+                         && (eof
+                             || (result.get_state().data() < end
+                                 && !reached_end));
+            if (!complete) {
+                if (eof || (!result && !reached_end)) {
+                    out.status = stream_status::parse_error;
+                    return out;
+                }
+                break;
+            }
+            if (result.get_state().data() == st.data()) {
+                // A record that consumes nothing would be produced forever
+                out.status = stream_status::parse_error;
+                return out;
+            }
+            out.records++;
+            out.bytes += result.get_state().data() - st.data();
+            st = result.get_state();
+            using value_t = decltype(std::move(result).get_value());
+            if constexpr (std::is_same_v<
+                              std::invoke_result_t<Func&, value_t>,
+                              bool>) {
+                if (!func(std::move(result).get_value())) {
+                    return out;
+                }
+            } else {
+                func(std::move(result).get_value());
+            }
+        }
+        if (eof) {
+            return out;
+        }
+
+        // Carry over the unparsed tail, then refill the rest of the buffer
+        size_t carry = end - st.data();
+        std::memmove(buffer_begin, st.data(), carry);
+        end = buffer_begin + carry;
+        size_t space = buffer_size - carry;
+        if (space == 0) {
+            out.status = stream_status::record_too_large;
+            return out;
+        }
+        ptrdiff_t count = source.read(end, space);
+        if (count < 0) {
+            out.status = stream_status::io_error;
+            return out;
+        }
+        eof = count == 0;
+        end += count;
+        st = state_t(buffer_begin, end);
+    }
+}
+
+/**
+ * @brief Streams records from a std::istream. See the primary overload.
+ */
+template <any_parser Parser, class Func>
+stream_result for_each_record(
+    std::istream& stream,
+    Parser const& parser,
+    Func&& func,
+    size_t buffer_size = default_stream_buffer_size) {
+    return for_each_record(
+        istream_source {&stream},
+        parser,
+        std::forward<Func>(func),
+        buffer_size);
+}
+
+#if NOAM_HAS_FD_SOURCE
+/**
+ * @brief Streams records from a file descriptor. See the primary overload.
+ */
+template <any_parser Parser, class Func>
+stream_result for_each_record(
+    int fd,
+    Parser const& parser,
+    Func&& func,
+    size_t buffer_size = default_stream_buffer_size) {
+    return for_each_record(
+        fd_source {fd},
+        parser,
+        std::forward<Func>(func),
+        buffer_size);
+}
+#endif
+} // namespace noam
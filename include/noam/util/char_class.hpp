@@ -0,0 +1,183 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace noam {
+/**
+ * @brief A pair of 16-entry tables which classify a byte by its low and high
+ * nibbles: a byte is in the class if `lo[byte & 15] & hi[byte >> 4]` is
+ * non-zero. This lets a whole block of bytes be classified with two byte
+ * shuffles.
+ *
+ * Not every set of bytes can be represented this way. If `exact` is false,
+ * the tables must not be used.
+ */
+struct nibble_table {
+    uint8_t lo[16] {};
+    uint8_t hi[16] {};
+    bool exact = false;
+};
+
+/**
+ * @brief A set of bytes, stored as a 256-bit bitmap. Testing if a character is
+ * in the set is a single table lookup, no matter how many characters are in
+ * it. char_class can be used as a template parameter, so classes are built at
+ * compile time:
+ *
+ * ```cpp
+ * constexpr noam::char_class hex = noam::char_class::range('0', '9')
+ *                                | noam::char_class::range('a', 'f')
+ *                                | noam::char_class::range('A', 'F');
+ * ```
+ */
+struct char_class {
+    uint64_t bits[4] {};
+
+    /**
+     * @brief Returns the class holding every character in `chars`
+     */
+    constexpr static char_class of(std::string_view chars) noexcept {
+        char_class result;
+        for (char ch : chars) {
+            result.insert(ch);
+        }
+        return result;
+    }
+    /**
+     * @brief Returns the class holding every character from first to last,
+     * inclusive
+     */
+    constexpr static char_class range(char first, char last) noexcept {
+        char_class result;
+        for (int ch = (unsigned char)first; ch <= (unsigned char)last; ch++) {
+            result.insert(char(ch));
+        }
+        return result;
+    }
+
+    constexpr void insert(char ch) noexcept {
+        unsigned char byte = ch;
+        bits[byte >> 6] |= uint64_t(1) << (byte & 63);
+    }
+    constexpr bool contains(char ch) const noexcept {
+        unsigned char byte = ch;
+        return (bits[byte >> 6] >> (byte & 63)) & 1;
+    }
+    /**
+     * @brief Expands the bitmap into one byte per character, which is
+     * cheaper to look up in a loop
+     */
+    constexpr std::array<bool, 256> table() const noexcept {
+        std::array<bool, 256> result {};
+        for (int byte = 0; byte < 256; byte++) {
+            result[byte] = contains(char(byte));
+        }
+        return result;
+    }
+    constexpr bool empty() const noexcept {
+        return (bits[0] | bits[1] | bits[2] | bits[3]) == 0;
+    }
+
+    constexpr char_class operator|(char_class other) const noexcept {
+        char_class result;
+        for (int i = 0; i < 4; i++) {
+            result.bits[i] = bits[i] | other.bits[i];
+        }
+        return result;
+    }
+    constexpr char_class operator&(char_class other) const noexcept {
+        char_class result;
+        for (int i = 0; i < 4; i++) {
+            result.bits[i] = bits[i] & other.bits[i];
+        }
+        return result;
+    }
+    /**
+     * @brief Returns the class holding every byte not in this class
+     */
+    constexpr char_class operator~() const noexcept {
+        char_class result;
+        for (int i = 0; i < 4; i++) {
+            result.bits[i] = ~bits[i];
+        }
+        return result;
+    }
+    constexpr bool operator==(char_class const&) const = default;
+
+    /**
+     * @brief Builds the nibble tables for this class. Bytes are grouped by
+     * their high nibble, and each distinct set of low nibbles gets one bit of
+     * the tables, so the tables are exact if there are at most 8 distinct
+     * (non-empty) sets of low nibbles. This is true of most classes made from
+     * ASCII ranges, such as identifiers or hex digits.
+     */
+    constexpr nibble_table nibbles() const noexcept {
+        nibble_table table;
+        uint16_t groups[8] {};
+        int group_count = 0;
+        for (int hi = 0; hi < 16; hi++) {
+            uint16_t lo_set = 0;
+            for (int lo = 0; lo < 16; lo++) {
+                if (contains(char(hi * 16 + lo))) {
+                    lo_set |= uint16_t(1 << lo);
+                }
+            }
+            if (lo_set == 0) {
+                continue;
+            }
+            int group = 0;
+            while (group < group_count && groups[group] != lo_set) {
+                group++;
+            }
+            if (group == group_count) {
+                if (group_count == 8) {
+                    return nibble_table {};
+                }
+                groups[group_count++] = lo_set;
+            }
+            table.hi[hi] |= uint8_t(1 << group);
+        }
+        for (int group = 0; group < group_count; group++) {
+            for (int lo = 0; lo < 16; lo++) {
+                if ((groups[group] >> lo) & 1) {
+                    table.lo[lo] |= uint8_t(1 << group);
+                }
+            }
+        }
+        table.exact = true;
+        return table;
+    }
+};
+
+/**
+ * @brief Commonly used character classes (ASCII only)
+ *
+ */
+namespace char_classes {
+constexpr char_class digit = char_class::range('0', '9');
+constexpr char_class lower = char_class::range('a', 'z');
+constexpr char_class upper = char_class::range('A', 'Z');
+constexpr char_class alpha = lower | upper;
+constexpr char_class alnum = alpha | digit;
+constexpr char_class hex_digit =
+    digit | char_class::range('a', 'f') | char_class::range('A', 'F');
+constexpr char_class space = char_class::of(" \t\n\r\f\v");
+/**
+ * @brief Characters which may start a C-style identifier: `[A-Za-z_]`
+ */
+constexpr char_class identifier_start = alpha | char_class::of("_");
+/**
+ * @brief Characters which may continue a C-style identifier: `[A-Za-z0-9_]`
+ */
+constexpr char_class identifier = alnum | char_class::of("_");
+} // namespace char_classes
+
+static_assert(char_classes::identifier.contains('_'));
+static_assert(!char_classes::identifier.contains('-'));
+static_assert(!char_classes::identifier.contains('\xff'));
+static_assert((~char_classes::digit).contains('\xff'));
+static_assert(char_classes::identifier.nibbles().exact);
+static_assert(char_classes::hex_digit.nibbles().exact);
+} // namespace noam
@@ -1,14 +1,30 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <noam/operators.hpp>
 #include <noam/parser.hpp>
 #include <noam/result_types.hpp>
+#include <noam/static_vector.hpp>
 #include <noam/type_traits.hpp>
+#include <noam/util/first_set.hpp>
 #include <noam/util/helpers.hpp>
+#include <noam/util/partial_input.hpp>
+#include <optional>
 #include <tuplet/tuple.hpp>
+#include <type_traits>
+#include <utility>
 
 // This file holds functios that return parsers based on inputs
 
+namespace noam {
+/**
+ * @brief The associativity of an infix operator: whether `a - b - c` means
+ * `(a - b) - c` (left) or `a - (b - c)` (right)
+ */
+enum class assoc { left, right };
+} // namespace noam
+
 /**
  * @brief noam::parsers contains the definitions of parser combinators
  *
@@ -29,6 +45,9 @@ template <class Func, class Parser>
 struct map {
     [[no_unique_address]] Func func;
     [[no_unique_address]] Parser parser;
+    constexpr static auto first_set() noexcept {
+        return first_set_of<Parser>();
+    }
     using result_before_map = parser_result_t<Parser>;
     constexpr static bool always_good = result_always_good_v<result_before_map>;
     using value_type = std::invoke_result_t<Func, parser_value_t<Parser>>;
@@ -55,6 +74,9 @@ struct enclose {
     [[no_unique_address]] Prefix prefix {};
     [[no_unique_address]] Value parser {};
     [[no_unique_address]] Postfix postfix {};
+    constexpr static auto first_set() noexcept {
+        return first_set_of<Prefix>();
+    }
     constexpr auto parse(state_t st) const {
         using value_type = parser_value_t<Value>;
         if (auto pre = prefix.parse(st)) {
@@ -79,6 +101,11 @@ struct match : tuplet::tuple<Parsers...> {
     constexpr static bool always_good = (parser_always_good_v<Parsers> && ...);
     using result_type = std::
         conditional_t<always_good, pure_result<empty>, result<empty>>;
+    // The first parser has to consume at least one byte for the match to
+    // succeed, if it has a FIRST set
+    constexpr static auto first_set() noexcept {
+        return first_set_of<meta::first_t<Parsers..., void>>();
+    }
     template <class... Bases>
     constexpr auto parse_impl(state_t st, tuplet::type_list<Bases...>) const
         -> result_type {
@@ -109,6 +136,9 @@ struct join : meta::all_but_last_t<match, P...> {
         parser_result_t<last_parser>,
         result<parser_value_t<last_parser>>>;
     last_parser p;
+    constexpr static auto first_set() noexcept {
+        return first_set_of<meta::first_t<P...>>();
+    }
     template <class... Bases>
     constexpr auto parse(state_t st) const -> result_type {
         if constexpr (match_t::always_good) {
@@ -129,6 +159,17 @@ struct join : meta::all_but_last_t<match, P...> {
 template <class... T>
 join(T...) -> join<T...>;
 
+/**
+ * @brief Wraps a parser, declaring that it only succeeds on input starting
+ * with a byte in `cls`. This gives parsers written as lambdas a FIRST set.
+ */
+template <char_class cls, class Parser>
+struct with_first_set {
+    [[no_unique_address]] Parser parser;
+    constexpr static char_class first_set() noexcept { return cls; }
+    constexpr auto parse(state_t st) const { return parser.parse(st); }
+};
+
 template <class T, class Func>
 struct recurse {
     struct ref_self {
@@ -152,4 +193,457 @@ struct recurse_constant {
         return parser.parse(st);
     }
 };
+
+enum class operator_kind { prefix, infix, postfix };
+
+/**
+ * @brief An operator in an operator_table. `Symbol` is the literal matched in
+ * the input, and `func` combines the operands (one for prefix and postfix
+ * operators, two for infix operators). Operators with a higher `Power` bind
+ * more tightly.
+ */
+template <
+    operator_kind Kind,
+    any_literal Symbol,
+    int Power,
+    assoc Associativity,
+    class Func>
+struct operator_def {
+    static_assert(Symbol.size() > 0, "Operators can't be empty");
+    static_assert(Power >= 0, "Binding powers can't be negative");
+    constexpr static operator_kind kind = Kind;
+    constexpr static auto symbol = Symbol;
+    // The least binding power of an expression this operator can extend,
+    // and the least binding power of its operand (for prefix and infix
+    // operators). Powers are doubled, so the right operand of a
+    // left-associative operator can bind one step more tightly.
+    constexpr static int left_power = Power * 2;
+    constexpr static int right_power =
+        Associativity == assoc::left ? Power * 2 + 1 : Power * 2;
+    [[no_unique_address]] Func func;
+};
+
+template <class... Ops>
+struct operator_table : tuplet::tuple<Ops...> {};
+template <class... Ops>
+operator_table(Ops...) -> operator_table<Ops...>;
+
+/**
+ * @brief Properties of the operators in a table, indexed by position, and
+ * which operators the next byte of the input could start
+ */
+template <class... Ops>
+struct operator_dispatch {
+    constexpr static size_t count = sizeof...(Ops);
+    std::array<operator_kind, count> kind {Ops::kind...};
+    std::array<int, count> left_power {Ops::left_power...};
+    std::array<int, count> right_power {Ops::right_power...};
+    bool has_postfix = ((Ops::kind == operator_kind::postfix) || ...);
+    char_class prefix;
+    // The highest left_power of any infix or postfix operator starting with
+    // each byte, or -1 if none does
+    std::array<int, 256> suffix_power {};
+    // The infix and postfix operators starting with each byte. Bit i is set
+    // if operator i starts with the byte.
+    std::array<uint64_t, 256> suffix_ops {};
+    // If the only infix or postfix operator starting with a byte is that
+    // byte alone, this is its index plus 1, so it can be matched without
+    // trying each operator. Otherwise, it's 0.
+    std::array<uint8_t, 256> single_byte_op {};
+
+    constexpr operator_dispatch() noexcept {
+        static_assert(count <= 64, "Operator tables hold up to 64 operators");
+        suffix_power.fill(-1);
+        size_t i = 0;
+        (add<Ops>(i++), ...);
+        i = 0;
+        (add_single_byte<Ops>(i++), ...);
+    }
+    template <class Op>
+    constexpr void add(size_t i) noexcept {
+        unsigned char byte = Op::symbol.view()[0];
+        if constexpr (Op::kind == operator_kind::prefix) {
+            prefix.insert(char(byte));
+        } else {
+            suffix_ops[byte] |= uint64_t(1) << i;
+            if (Op::left_power > suffix_power[byte]) {
+                suffix_power[byte] = Op::left_power;
+            }
+        }
+    }
+    template <class Op>
+    constexpr void add_single_byte(size_t i) noexcept {
+        unsigned char byte = Op::symbol.view()[0];
+        if (Op::kind != operator_kind::prefix && Op::symbol.size() == 1
+            && suffix_ops[byte] == uint64_t(1) << i) {
+            single_byte_op[byte] = uint8_t(i + 1);
+        }
+    }
+};
+
+/**
+ * @brief Parses expressions made of operands and the operators in an
+ * operator_table, by precedence climbing. It's written as a single loop,
+ * which parses each operand in one place: an infix operator binding more
+ * tightly than the one before it is kept on a stack, instead of recursing.
+ * The next byte is looked up in an operator_dispatch, so only operators
+ * starting with that byte are tried.
+ */
+template <class Operand, class... Ops>
+struct pratt {
+    [[no_unique_address]] Operand operand;
+    [[no_unique_address]] operator_table<Ops...> operators;
+    using value_type = parser_value_t<Operand>;
+    using result_type = result<value_type>;
+    using base_list = typename tuplet::tuple<Ops...>::base_list;
+    constexpr static operator_dispatch<Ops...> dispatch {};
+
+    // An expression starts with a prefix operator or an operand
+    constexpr static auto first_set() noexcept {
+        std::optional<char_class> result = first_set_of<Operand>();
+        if (result) {
+            *result = *result | dispatch.prefix;
+        }
+        return result;
+    }
+
+    constexpr auto parse(state_t st) const -> result_type {
+        return parse_expression(st, 0, base_list {});
+    }
+
+   private:
+    // An infix operator waiting for its right operand, which is followed by
+    // an operator binding more tightly (so that operator is applied first)
+    struct pending {
+        value_type lhs;
+        size_t index;
+        int min_power;
+    };
+    // Values which can't be default constructed aren't kept on a stack, so
+    // nested operators recurse instead
+    constexpr static size_t max_pending =
+        std::is_default_constructible_v<value_type> ? 16 : 0;
+
+    // Returns the highest binding power of an operator which could extend
+    // an expression stopping at `st`, or -1
+    constexpr static int suffix_power(state_t st) noexcept {
+        if (st.empty()) {
+            note_end_of_input();
+            return -1;
+        }
+        return dispatch.suffix_power[(unsigned char)st[0]];
+    }
+
+    // Parses an expression whose operators all bind at least `min_power`.
+    // If the right operand of an infix operator doesn't parse, the operator
+    // is left in the input (and later operators are tried).
+    template <class... Bases>
+    constexpr auto parse_expression(
+        state_t st,
+        int min_power,
+        tuplet::type_list<Bases...> bases) const -> result_type {
+        std::array<pending, max_pending> stack;
+        size_t depth = 0;
+        result_type lhs;
+        bool has_lhs = false;
+        // Set when an infix operator was matched, so its right operand (at
+        // `st`) is parsed next
+        bool operand_next = true;
+        size_t index = 0;
+        // Operators before this one are skipped, because their right operand
+        // didn't parse
+        size_t first = 0;
+        while (true) {
+            if (operand_next) {
+                operand_next = false;
+                result_type rhs = parse_operand(st, bases);
+                if (!has_lhs) {
+                    if (!rhs) {
+                        return {};
+                    }
+                    lhs = std::move(rhs);
+                    has_lhs = true;
+                } else if (!rhs) {
+                    first = index + 1;
+                } else {
+                    first = 0;
+                    int right_power = dispatch.right_power[index];
+                    if (suffix_power(rhs.get_state()) >= right_power) {
+                        if (depth < max_pending) {
+                            stack[depth++] = {
+                                std::move(lhs).get_value(),
+                                index,
+                                min_power};
+                            lhs = std::move(rhs);
+                            min_power = right_power;
+                            continue;
+                        }
+                        // The stack is full, so the right operand is parsed
+                        // again, as an expression of its own
+                        rhs = parse_expression(st, right_power, bases);
+                    }
+                    ((index_of<Bases> == index
+                      && apply<Bases>(std::move(lhs).get_value(), rhs))
+                     || ...);
+                    lhs = std::move(rhs);
+                }
+            }
+            st = lhs.get_state();
+            if (!match_suffix(st, min_power, first, index, bases)) {
+                if (depth == 0) {
+                    return {lhs.get_state(), std::move(lhs).get_value()};
+                }
+                // The right operand of the pending operator is complete
+                pending& top = stack[--depth];
+                ((index_of<Bases> == top.index
+                  && apply<Bases>(std::move(top.lhs), lhs))
+                 || ...);
+                min_power = top.min_power;
+                first = 0;
+                continue;
+            }
+            if (dispatch.has_postfix
+                && dispatch.kind[index] == operator_kind::postfix) {
+                ((index_of<Bases> == index && apply<Bases>(lhs, st)) || ...);
+                first = 0;
+                continue;
+            }
+            operand_next = true;
+        }
+    }
+
+    // Parses an operand, and any prefix operators before it
+    template <class... Bases>
+    constexpr auto parse_operand(state_t st, tuplet::type_list<Bases...> bases)
+        const -> result_type {
+        if (!st.empty() && dispatch.prefix.contains(st[0])) {
+            result_type result;
+            if ((parse_prefix(operators.Bases::value, st, result, bases)
+                 || ...)) {
+                return {result.get_state(), std::move(result).get_value()};
+            }
+        }
+        auto r = operand.parse(st);
+        if (!r) {
+            return {};
+        }
+        return {r.get_state(), std::move(r).get_value()};
+    }
+
+    template <class Op, class Bases>
+    constexpr bool parse_prefix(
+        Op const& op,
+        state_t st,
+        result_type& result,
+        Bases bases) const {
+        if constexpr (Op::kind != operator_kind::prefix) {
+            return false;
+        } else {
+            if (!Op::symbol.check_and_update(st)) {
+                return false;
+            }
+            auto r = parse_expression(st, Op::right_power, bases);
+            if (!r) {
+                return false;
+            }
+            result = {r.get_state(), op.func(std::move(r).get_value())};
+            return true;
+        }
+    }
+
+    template <class Base>
+    struct base_index;
+    template <size_t I, class Op>
+    struct base_index<tuplet::tuple_elem<I, Op>> {
+        constexpr static size_t value = I;
+    };
+    // The position of an operator in the table
+    template <class Base>
+    constexpr static size_t index_of = base_index<Base>::value;
+
+    // Matches the symbol of an infix or postfix operator at `st`, if it
+    // binds at least `min_power`. Only operators starting with the next byte
+    // are tried, skipping those before `first`.
+    template <class... Bases>
+    constexpr static bool match_suffix(
+        state_t& st,
+        int min_power,
+        size_t first,
+        size_t& index,
+        tuplet::type_list<Bases...>) noexcept {
+        if (suffix_power(st) < min_power) {
+            return false;
+        }
+        if (size_t single = dispatch.single_byte_op[(unsigned char)st[0]]) {
+            index = single - 1;
+            if (index < first || dispatch.left_power[index] < min_power) {
+                return false;
+            }
+            st.remove_prefix(1);
+            return true;
+        }
+        uint64_t ops = dispatch.suffix_ops[(unsigned char)st[0]];
+        ops &= ~uint64_t(0) << first;
+        return ((((ops >> index_of<Bases>) & 1)
+                 && match_one<Bases>(st, min_power, index))
+                || ...);
+    }
+    template <class Base>
+    constexpr static bool match_one(
+        state_t& st,
+        int min_power,
+        size_t& index) noexcept {
+        using Op = std::remove_cvref_t<decltype(Base::value)>;
+        if (Op::left_power < min_power || !Op::symbol.check_and_update(st)) {
+            return false;
+        }
+        index = index_of<Base>;
+        return true;
+    }
+
+    // Applies a postfix operator to lhs, which ends at `st`
+    template <class Base>
+    constexpr bool apply(result_type& lhs, state_t st) const {
+        using Op = std::remove_cvref_t<decltype(Base::value)>;
+        if constexpr (Op::kind == operator_kind::postfix) {
+            auto const& op = operators.Base::value;
+            lhs = {st, op.func(std::move(lhs).get_value())};
+        }
+        return true;
+    }
+    // Applies an infix operator to lhs and rhs, storing the result in rhs
+    template <class Base>
+    constexpr bool apply(value_type&& lhs, result_type& rhs) const {
+        using Op = std::remove_cvref_t<decltype(Base::value)>;
+        if constexpr (Op::kind == operator_kind::infix) {
+            auto const& op = operators.Base::value;
+            rhs = {
+                rhs.get_state(),
+                op.func(std::move(lhs), std::move(rhs).get_value())};
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Parses exactly `N` elements, with `sep` between them, into a
+ * std::array. The parse is unrolled: each element is parsed by its own call,
+ * so there's no loop or count. Elements which can't be default-constructed
+ * are parsed into a static_vector first, and then moved into the array.
+ */
+template <size_t N, class Elem, class Sep>
+struct repeat {
+    [[no_unique_address]] Elem elem;
+    [[no_unique_address]] Sep sep;
+    using elem_type = parser_value_t<Elem>;
+    using value_type = std::array<elem_type, N>;
+    constexpr static bool always_good =
+        N == 0
+        || (parser_always_good_v<Elem>
+            && (N == 1 || parser_always_good_v<Sep>));
+    using result_type = get_result_t<value_type, always_good>;
+
+    constexpr static std::optional<char_class> first_set() noexcept {
+        if constexpr (N == 0) {
+            return std::nullopt;
+        } else {
+            return first_set_of<Elem>();
+        }
+    }
+
+    constexpr auto parse(state_t st) const -> result_type {
+        return parse_impl(st, std::make_index_sequence<N>());
+    }
+
+   private:
+    template <size_t... I>
+    constexpr auto parse_impl(state_t st, std::index_sequence<I...>) const
+        -> result_type {
+        if constexpr (std::is_default_constructible_v<elem_type>) {
+            value_type values;
+            bool good = (parse_element<I>(st, values) && ...);
+            if constexpr (!always_good) {
+                if (!good) {
+                    return {};
+                }
+            }
+            return result_type {st, std::move(values)};
+        } else {
+            static_vector<elem_type, N> values;
+            bool good = (parse_element<I>(st, values) && ...);
+            if constexpr (!always_good) {
+                if (!good) {
+                    return {};
+                }
+            }
+            return result_type {st, value_type {std::move(values[I])...}};
+        }
+    }
+    template <size_t I, class Values>
+    constexpr bool parse_element(state_t& st, Values& values) const {
+        if constexpr (I > 0) {
+            if (!update_state(sep.parse(st), st)) {
+                return false;
+            }
+        }
+        auto r = elem.parse(st);
+        if (!r) {
+            return false;
+        }
+        st = r.get_state();
+        // Matches the choice of container in parse_impl
+        if constexpr (std::is_default_constructible_v<elem_type>) {
+            values[I] = std::move(r).get_value();
+        } else {
+            values.emplace_back(std::move(r).get_value());
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Parses between `Min` and `Max` elements, with `sep` between them,
+ * into a static_vector. Parsing stops after `Max` elements, or before a
+ * separator which isn't followed by an element, and fails if there are fewer
+ * than `Min` elements.
+ */
+template <size_t Min, size_t Max, class Elem, class Sep>
+struct repeat_between {
+    static_assert(Min <= Max, "Min can't be more than Max");
+    [[no_unique_address]] Elem elem;
+    [[no_unique_address]] Sep sep;
+    using elem_type = parser_value_t<Elem>;
+    using value_type = static_vector<elem_type, Max>;
+    using result_type = get_result_t<value_type, Min == 0>;
+
+    constexpr static std::optional<char_class> first_set() noexcept {
+        if constexpr (Min == 0) {
+            return std::nullopt;
+        } else {
+            return first_set_of<Elem>();
+        }
+    }
+
+    auto parse(state_t st) const -> result_type {
+        value_type values;
+        while (values.size() < Max) {
+            state_t next = st;
+            if (!values.empty() && !update_state(sep.parse(next), next)) {
+                break;
+            }
+            auto r = elem.parse(next);
+            if (!r) {
+                break;
+            }
+            st = r.get_state();
+            values.emplace_back(std::move(r).get_value());
+        }
+        if constexpr (Min > 0) {
+            if (values.size() < Min) {
+                return {};
+            }
+        }
+        return {st, std::move(values)};
+    }
+};
 } // namespace noam::parsers
@@ -0,0 +1,65 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace noam {
+/**
+ * @brief A string which either refers to existing text, or owns its own
+ * copy. Produced by noam::parse_string_cow, which only allocates when a string
+ * contains escape sequences that have to be decoded.
+ *
+ * A borrowed cow_string is only valid for as long as the input it was parsed
+ * from.
+ *
+ */
+class cow_string {
+    std::string_view borrowed;
+    std::string owned;
+    bool is_owned = false;
+
+   public:
+    cow_string() = default;
+    /**
+     * @brief Refers to existing text, without copying it
+     */
+    constexpr explicit cow_string(std::string_view text) noexcept
+      : borrowed(text) {}
+    /**
+     * @brief Takes ownership of a string
+     */
+    explicit cow_string(std::string text) noexcept
+      : owned(std::move(text))
+      , is_owned(true) {}
+
+    /**
+     * @brief Returns true if the string owns its text (i.e., the text had to
+     * be decoded), and false if it refers to the input
+     */
+    bool owns_text() const noexcept { return is_owned; }
+
+    std::string_view view() const noexcept {
+        return is_owned ? std::string_view(owned) : borrowed;
+    }
+    operator std::string_view() const noexcept { return view(); }
+
+    char const* data() const noexcept { return view().data(); }
+    size_t size() const noexcept { return view().size(); }
+    bool empty() const noexcept { return view().empty(); }
+
+    /**
+     * @brief Returns the text as a std::string, moving it if it's owned
+     */
+    std::string str() && {
+        return is_owned ? std::move(owned) : std::string(borrowed);
+    }
+    std::string str() const& { return std::string(view()); }
+
+    bool operator==(cow_string const& other) const noexcept {
+        return view() == other.view();
+    }
+    bool operator==(std::string_view other) const noexcept {
+        return view() == other;
+    }
+};
+} // namespace noam
@@ -0,0 +1,169 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+/**
+ * @brief Base-10 integer parsing which converts 8 digits at a time using
+ * SWAR (SIMD within a register) arithmetic on a 64-bit word.
+ *
+ */
+namespace noam::decimal {
+/**
+ * @brief Returns true if all 8 bytes of the (little-endian) word are ASCII
+ * digits
+ */
+constexpr bool is_eight_digits(uint64_t word) noexcept {
+    return ((word & 0xF0F0F0F0F0F0F0F0)
+            | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+        == 0x3333333333333333;
+}
+
+/**
+ * @brief Converts 8 ASCII digits, loaded as a little-endian word, to their
+ * value. Adjacent digits are combined into pairs, then pairs into groups of 4,
+ * then the two groups into the result.
+ */
+constexpr uint32_t parse_eight_digits(uint64_t word) noexcept {
+    word -= 0x3030303030303030;
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FF) * (100 + (1000000ull << 32)))
+            + (((word >> 16) & 0x000000FF000000FF) * (1 + (10000ull << 32))))
+        >> 32;
+    return uint32_t(word);
+}
+
+constexpr bool is_digit(char ch) noexcept { return '0' <= ch && ch <= '9'; }
+
+/**
+ * @brief Returns a mask with the high bit set in each byte of the
+ * (little-endian) word which isn't an ASCII digit. Bytes after the first
+ * non-digit may also be marked, so only the lowest set bit is meaningful.
+ */
+constexpr uint64_t non_digit_mask(uint64_t word) noexcept {
+    uint64_t x = word ^ 0x3030303030303030;
+    // Digits are now 0-9. Adding 0x76 sets the high bit of anything larger.
+    return ((x + 0x7676767676767676) | x) & 0x8080808080808080;
+}
+
+constexpr uint64_t powers_of_10[] {
+    1,
+    10,
+    100,
+    1000,
+    10000,
+    100000,
+    1000000,
+    10000000,
+    100000000};
+
+/**
+ * @brief Converts the digits in [begin, end) to a value, returning false on
+ * overflow
+ */
+constexpr bool parse_digits_checked(
+    char const* begin,
+    char const* end,
+    uint64_t& acc) noexcept {
+    constexpr uint64_t max = std::numeric_limits<uint64_t>::max();
+    acc = 0;
+    for (; begin < end; begin++) {
+        uint64_t digit = uint64_t(*begin - '0');
+        if (acc > (max - digit) / 10) {
+            return false;
+        }
+        acc = acc * 10 + digit;
+    }
+    return true;
+}
+
+/**
+ * @brief Parses a base-10 integer at the start of [begin, end), with the same
+ * syntax and overflow behavior as std::from_chars: an optional '-' (for
+ * signed types only) followed by one or more digits, failing if the value
+ * doesn't fit in T.
+ *
+ * Up to 8 digits are converted at a time: the digits are loaded as a word,
+ * the number of leading digits is found from the non-digit mask, and the
+ * digits are shifted into place and converted together.
+ *
+ * If `checked` is false, the input is assumed to already be valid: overflow
+ * isn't detected, and the value wraps instead.
+ *
+ * @return char const* a pointer past the last digit, or nullptr on failure
+ */
+template <class T, bool checked = true>
+char const* parse(char const* begin, char const* end, T& value) noexcept {
+    static_assert(std::is_integral_v<T>);
+    char const* pos = begin;
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (pos < end && *pos == '-') {
+            negative = true;
+            pos++;
+        }
+    }
+    char const* digits = pos;
+    uint64_t acc = 0;
+    bool found_end = false;
+    if constexpr (std::endian::native == std::endian::little) {
+        while (end - pos >= 8) {
+            uint64_t word;
+            std::memcpy(&word, pos, 8);
+            uint64_t mask = non_digit_mask(word);
+            if (mask == 0) {
+                acc = acc * 100000000 + parse_eight_digits(word);
+                pos += 8;
+                continue;
+            }
+            int count = std::countr_zero(mask) / 8;
+            if (count < 4) {
+                // Short runs are quicker to convert one digit at a time
+                for (int i = 0; i < count; i++) {
+                    acc = acc * 10 + uint64_t(pos[i] - '0');
+                }
+            } else {
+                // Move the digits to the end of the word, and fill the
+                // start with '0's
+                word = (word << (8 * (8 - count)))
+                     | (0x3030303030303030 >> (8 * count));
+                acc = acc * powers_of_10[count] + parse_eight_digits(word);
+            }
+            pos += count;
+            found_end = true;
+            break;
+        }
+    }
+    if (!found_end) {
+        for (; pos < end && is_digit(*pos); pos++) {
+            acc = acc * 10 + uint64_t(*pos - '0');
+        }
+    }
+    if (pos == digits) {
+        return nullptr;
+    }
+
+    using unsigned_t = std::make_unsigned_t<T>;
+    constexpr uint64_t max = std::numeric_limits<T>::max();
+    if constexpr (checked) {
+        // Any 19 digit number fits in 64 bits. Longer numbers (which may
+        // just have leading zeros) are converted again with overflow checks.
+        if (pos - digits > 19 && !parse_digits_checked(digits, pos, acc)) {
+            return nullptr;
+        }
+        if (acc > max + negative) {
+            return nullptr;
+        }
+    }
+    if (negative) {
+        // Negate in unsigned arithmetic, so that the minimum value of T
+        // doesn't overflow
+        value = T(unsigned_t(0) - unsigned_t(acc));
+    } else {
+        value = T(acc);
+    }
+    return pos;
+}
+} // namespace noam::decimal
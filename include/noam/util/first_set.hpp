@@ -0,0 +1,141 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <noam/state.hpp>
+#include <noam/util/char_class.hpp>
+#include <noam/util/literal.hpp>
+#include <noam/util/partial_input.hpp>
+#include <optional>
+#include <type_traits>
+
+namespace noam {
+/**
+ * @brief Returns the FIRST set of a parser: the bytes its input must start
+ * with for it to succeed. A parser declares this with a static member
+ * function `first_set()`, returning either a char_class or a
+ * std::optional<char_class> (which is empty if the parser doesn't know).
+ *
+ * A parser with a FIRST set never succeeds on empty input, so parsers which
+ * can succeed without consuming anything (such as `whitespace`) don't have
+ * one. Parsers which don't declare a FIRST set give std::nullopt.
+ */
+template <class Parser>
+constexpr std::optional<char_class> first_set_of() noexcept {
+    using P = std::remove_cvref_t<Parser>;
+    if constexpr (requires { P::first_set(); }) {
+        return P::first_set();
+    } else {
+        return std::nullopt;
+    }
+}
+
+/**
+ * @brief The FIRST set of a parser, expanded into a table. Only valid if the
+ * parser has a FIRST set.
+ */
+template <class Parser>
+constexpr std::array<bool, 256> first_set_table =
+    first_set_of<Parser>()->table();
+
+/**
+ * @brief Checks if a parser could succeed on the given input, judging only by
+ * its first byte. Parsers without a FIRST set could always succeed.
+ */
+template <class Parser>
+constexpr bool may_match(state_t st) noexcept {
+    if constexpr (first_set_of<Parser>().has_value()) {
+        if (st.empty()) {
+            note_end_of_input();
+            return false;
+        }
+        return first_set_table<Parser>[(unsigned char)st[0]];
+    } else {
+        return true;
+    }
+}
+
+/**
+ * @brief Parses the input with `p`, unless the FIRST set of p rules the input
+ * out, in which case the parse fails without calling p
+ */
+template <class Parser>
+constexpr auto parse_if_may_match(Parser const& p, state_t st) {
+    if constexpr (first_set_of<Parser>().has_value()) {
+        if (!may_match<Parser>(st)) {
+            return decltype(p.parse(st)) {};
+        }
+    }
+    return p.parse(st);
+}
+
+/**
+ * @brief The FIRST set of a set of literals, which is empty if any of them is
+ * the empty literal (since it matches any input)
+ */
+template <any_literal... Literals>
+constexpr std::optional<char_class> literal_first_set() noexcept {
+    if (((Literals.size() == 0) || ...)) {
+        return std::nullopt;
+    }
+    char_class result;
+    (result.insert(Literals.view()[0]), ...);
+    return result;
+}
+
+/**
+ * @brief Lists, for each possible first byte of the input, the alternatives
+ * which could match it. Bit i of a mask is set if alternative i could match.
+ * Alternatives without a FIRST set are in every mask.
+ *
+ * @tparam Parsers the alternatives, in order
+ */
+template <class... Parsers>
+struct first_set_dispatch {
+    constexpr static size_t count = sizeof...(Parsers);
+    using mask_t = std::conditional_t<
+        (count <= 8),
+        uint8_t,
+        std::conditional_t<
+            (count <= 16),
+            uint16_t,
+            std::conditional_t<(count <= 32), uint32_t, uint64_t>>>;
+
+    // True if at least one alternative can be ruled out by the first byte
+    bool useful = false;
+    mask_t on_empty = 0;
+    std::array<mask_t, 256> on_byte {};
+
+    constexpr first_set_dispatch() noexcept {
+        std::optional<char_class> first_sets[] {first_set_of<Parsers>()...};
+        for (size_t i = 0; i < count && i < 64; i++) {
+            mask_t bit = mask_t(1) << i;
+            if (!first_sets[i]) {
+                on_empty |= bit;
+            } else {
+                useful = true;
+            }
+            for (int byte = 0; byte < 256; byte++) {
+                if (!first_sets[i] || first_sets[i]->contains(char(byte))) {
+                    on_byte[byte] |= bit;
+                }
+            }
+        }
+        // Masks can't describe more than 64 alternatives
+        useful = useful && count <= 64;
+    }
+
+    /**
+     * @brief The alternatives which could match the input
+     */
+    constexpr mask_t candidates(state_t st) const noexcept {
+        if (st.empty()) {
+            note_end_of_input();
+            return on_empty;
+        }
+        return on_byte[(unsigned char)st[0]];
+    }
+};
+
+template <class... Parsers>
+constexpr first_set_dispatch<Parsers...> first_set_dispatch_for {};
+} // namespace noam
@@ -0,0 +1,284 @@
+#pragma once
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// Floats and doubles are parsed with fast_float when it's available. Define
+// NOAM_USE_FAST_FLOAT to 0 to use std::from_chars instead, or to 1 to require
+// fast_float. Either way, numbers too large or too small to represent are an
+// error, so the result is the same; only the speed differs.
+#ifndef NOAM_USE_FAST_FLOAT
+#if __has_include(<fast_float/fast_float.h>)
+#define NOAM_USE_FAST_FLOAT 1
+#else
+#define NOAM_USE_FAST_FLOAT 0
+#endif
+#endif
+
+#if NOAM_USE_FAST_FLOAT
+#include <fast_float/fast_float.h>
+#endif
+
+namespace noam {
+/**
+ * @brief The grammar accepted when parsing a floating point number
+ *
+ */
+enum class number_format {
+    /**
+     * @brief The grammar accepted by std::from_chars: an optional '-', then
+     * either digits with an optional decimal point and exponent (such as
+     * "1", "1.", ".5", or "2.5e-3"), or "inf", "infinity", or "nan" in any
+     * case.
+     */
+    general,
+    /**
+     * @brief The JSON number grammar: an optional '-', then an integer part
+     * without leading zeros, an optional fraction with at least one digit,
+     * and an optional exponent. Parsing stops at the end of the longest
+     * prefix which is a JSON number, so "01" parses as 0, leaving "1".
+     */
+    json,
+};
+} // namespace noam
+
+/**
+ * @brief Floating point parsing which behaves the same on every standard
+ * library
+ *
+ */
+namespace noam::floating {
+constexpr bool is_digit(char ch) noexcept { return '0' <= ch && ch <= '9'; }
+
+constexpr char const* skip_digits(char const* pos, char const* end) noexcept {
+    while (pos < end && is_digit(*pos)) {
+        pos++;
+    }
+    return pos;
+}
+
+/**
+ * @brief Returns the end of the exponent starting at pos, or pos if there
+ * isn't a complete exponent there
+ */
+constexpr char const* skip_exponent(char const* pos, char const* end) noexcept {
+    if (pos == end || (*pos != 'e' && *pos != 'E')) {
+        return pos;
+    }
+    char const* digits = pos + 1;
+    if (digits < end && (*digits == '+' || *digits == '-')) {
+        digits++;
+    }
+    if (digits == end || !is_digit(*digits)) {
+        return pos;
+    }
+    return skip_digits(digits, end);
+}
+
+/**
+ * @brief Returns the end of the longest prefix of [pos, end) which is a JSON
+ * number, or nullptr if the input doesn't start with one
+ */
+constexpr char const* scan_json(char const* pos, char const* end) noexcept {
+    if (pos < end && *pos == '-') {
+        pos++;
+    }
+    if (pos == end) {
+        return nullptr;
+    }
+    if (*pos == '0') {
+        pos++;
+    } else if (is_digit(*pos)) {
+        pos = skip_digits(pos + 1, end);
+    } else {
+        return nullptr;
+    }
+    if (end - pos >= 2 && pos[0] == '.' && is_digit(pos[1])) {
+        pos = skip_digits(pos + 2, end);
+    }
+    return skip_exponent(pos, end);
+}
+
+/**
+ * @brief Checks if [pos, end) starts with `word`, ignoring case. `word` must
+ * be lowercase.
+ */
+constexpr bool starts_with_word(
+    char const* pos,
+    char const* end,
+    std::string_view word) noexcept {
+    if (size_t(end - pos) < word.size()) {
+        return false;
+    }
+    for (char ch : word) {
+        if ((*pos++ | 0x20) != ch) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the end of the longest prefix of [pos, end) matching
+ * number_format::general, or nullptr if the input doesn't start with a number
+ */
+constexpr char const* scan_general(char const* pos, char const* end) noexcept {
+    if (pos < end && *pos == '-') {
+        pos++;
+    }
+    if (starts_with_word(pos, end, "infinity")) {
+        return pos + 8;
+    }
+    if (starts_with_word(pos, end, "inf")) {
+        return pos + 3;
+    }
+    if (starts_with_word(pos, end, "nan")) {
+        pos += 3;
+        // An optional sequence of letters, digits and underscores in parens
+        char const* tag = pos;
+        if (tag < end && *tag == '(') {
+            do {
+                tag++;
+            } while (tag < end
+                     && (is_digit(*tag) || ('a' <= (*tag | 0x20)
+                                            && (*tag | 0x20) <= 'z')
+                         || *tag == '_'));
+            if (tag < end && *tag == ')') {
+                pos = tag + 1;
+            }
+        }
+        return pos;
+    }
+    char const* mantissa = pos;
+    pos = skip_digits(pos, end);
+    bool has_digits = pos != mantissa;
+    if (pos < end && *pos == '.') {
+        char const* fraction = skip_digits(pos + 1, end);
+        has_digits = has_digits || fraction != pos + 1;
+        pos = fraction;
+    }
+    if (!has_digits) {
+        return nullptr;
+    }
+    return skip_exponent(pos, end);
+}
+
+/**
+ * @brief Parses a long double with std::strtold, for standard libraries which
+ * don't provide std::from_chars for long double. The number is found with
+ * scan_general first, so that strtold sees exactly the same text that
+ * from_chars would accept. strtold uses the decimal point of the current C
+ * locale, which is '.' unless the program changes it.
+ */
+inline char const* parse_with_strtold(
+    char const* begin,
+    char const* end,
+    long double& value) {
+    char const* number_end = scan_general(begin, end);
+    if (!number_end) {
+        return nullptr;
+    }
+    // Most numbers fit in the local buffer. Longer ones are copied to a string
+    // so that they can be null terminated.
+    char local[64];
+    std::string long_number;
+    size_t size = number_end - begin;
+    char* text = local;
+    if (size >= sizeof(local)) {
+        long_number.assign(begin, number_end);
+        text = long_number.data();
+    } else {
+        std::memcpy(local, begin, size);
+        local[size] = '\0';
+    }
+    char* parsed_end = nullptr;
+    errno = 0;
+    value = std::strtold(text, &parsed_end);
+    if (parsed_end != text + size || errno == ERANGE) {
+        return nullptr;
+    }
+    return number_end;
+}
+
+/**
+ * @brief Checks that a finite, non-zero number wasn't rounded to infinity or
+ * zero. fast_float (at least up to v1.1.2) gives infinity for "1e999" and
+ * zero for "1e-400" without reporting an error, where std::from_chars reports
+ * std::errc::result_out_of_range.
+ *
+ * @param begin the start of the number's text
+ * @param end the end of the number's text
+ * @param value the value parsed from it
+ */
+template <class T>
+constexpr bool in_range(char const* begin, char const* end, T value) noexcept {
+    if (begin < end && *begin == '-') {
+        begin++;
+    }
+    if (value == T(0)) {
+        // Zero is only in range if every digit of the mantissa is zero
+        for (; begin < end && *begin != 'e' && *begin != 'E'; begin++) {
+            if ('1' <= *begin && *begin <= '9') {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool is_inf = value == std::numeric_limits<T>::infinity()
+               || value == -std::numeric_limits<T>::infinity();
+    // Only "inf" and "infinity" are allowed to be infinite
+    return !is_inf || (begin < end && (*begin | 0x20) == 'i');
+}
+
+/**
+ * @brief Parses a floating point number at the start of [begin, end) using
+ * the given grammar. Out-of-range numbers are an error, as with
+ * std::from_chars.
+ *
+ * float and double are parsed with fast_float if NOAM_USE_FAST_FLOAT is set,
+ * and with std::from_chars otherwise. fast_float doesn't support long double,
+ * so long double uses std::from_chars when the standard library provides it,
+ * and std::strtold when it doesn't. long double is never parsed as a double,
+ * so no precision is lost.
+ *
+ * @return char const* a pointer past the end of the number, or nullptr on
+ * failure
+ */
+template <class T, number_format format = number_format::general>
+char const* parse(char const* begin, char const* end, T& value) {
+    static_assert(std::is_floating_point_v<T>);
+    if constexpr (format == number_format::json) {
+        // JSON numbers are a subset of the general grammar, so once the
+        // extent of the number is known, the general parser can convert it
+        end = scan_json(begin, end);
+        if (!end) {
+            return nullptr;
+        }
+    }
+    if constexpr (std::is_same_v<T, long double>) {
+#ifdef __cpp_lib_to_chars
+        auto result = std::from_chars(begin, end, value);
+        return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+        return parse_with_strtold(begin, end, value);
+#endif
+    } else {
+#if NOAM_USE_FAST_FLOAT
+        auto result = fast_float::from_chars(begin, end, value);
+        if (result.ec == std::errc()
+            && !in_range(begin, result.ptr, value)) {
+            return nullptr;
+        }
+#else
+        auto result = std::from_chars(begin, end, value);
+#endif
+        return result.ec == std::errc() ? result.ptr : nullptr;
+    }
+}
+} // namespace noam::floating
@@ -4,6 +4,7 @@
 #include <fmt/format.h>
 #include <noam/parser.hpp>
 #include <noam/type_traits.hpp>
+#include <noam/util/cow_string.hpp>
 #include <noam/util/reflection.hpp>
 
 template <noam::parse_result R>
@@ -35,6 +36,16 @@ struct fmt::formatter<noam::state_t> : fmt::formatter<std::string_view> {
     }
 };
 
+template <>
+struct fmt::formatter<noam::cow_string> : fmt::formatter<std::string_view> {
+    using base = fmt::formatter<std::string_view>;
+    // parse is inherited from formatter<string_view>.
+    template <typename FormatContext>
+    decltype(auto) format(noam::cow_string const& str, FormatContext& ctx) {
+        return base::format(str.view(), ctx);
+    }
+};
+
 template <class T>
 struct fmt::formatter<noam::parser<T>> : fmt::formatter<std::string_view> {
     template <typename FormatContext>
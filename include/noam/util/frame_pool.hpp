@@ -0,0 +1,175 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+// Coroutine frames for parse_promise are allocated through noam::frame_pool
+// unless this is defined to 0, in which case the compiler's default
+// allocation (and any heap allocation elision it can perform) is used
+#ifndef NOAM_COROUTINE_FRAME_POOL
+#define NOAM_COROUTINE_FRAME_POOL 1
+#endif
+
+namespace noam {
+/**
+ * @brief A thread-local cache of coroutine frames, bucketed by size. Frames
+ * are rounded up to a multiple of `granularity` bytes, and freed frames are
+ * kept on a per-bucket free list so that the next coroutine parser of a
+ * similar size can reuse them without calling into the heap.
+ *
+ * If a std::pmr::memory_resource has been installed on the current thread via
+ * noam::scoped_frame_resource, frames are allocated from that resource instead.
+ */
+class frame_pool {
+    struct node {
+        node* next;
+    };
+    struct bucket {
+        node* head = nullptr;
+        size_t count = 0;
+    };
+
+    // Every frame is prefixed by a header recording the resource it came from
+    // (or nullptr if it came from the pool). This allows a frame to be freed
+    // correctly even if a different resource is installed by then.
+    constexpr static size_t header_size = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    constexpr static size_t bucket_count = 16;
+
+    bucket buckets[bucket_count] {};
+    std::pmr::memory_resource* resource = nullptr;
+
+    frame_pool() = default;
+    ~frame_pool() {
+        for (bucket& b : buckets) {
+            while (node* n = b.head) {
+                b.head = n->next;
+                ::operator delete(n);
+            }
+        }
+    }
+
+    constexpr static size_t bucket_index(size_t size) noexcept {
+        return (size - 1) / granularity;
+    }
+
+    void* allocate_block(size_t size) {
+        size_t index = bucket_index(size);
+        if (index < bucket_count) {
+            bucket& b = buckets[index];
+            if (node* n = b.head) {
+                b.head = n->next;
+                b.count--;
+                return n;
+            }
+            return ::operator new((index + 1) * granularity);
+        }
+        return ::operator new(size);
+    }
+    void deallocate_block(void* block, size_t size) noexcept {
+        size_t index = bucket_index(size);
+        if (index < bucket_count && buckets[index].count < max_cached) {
+            bucket& b = buckets[index];
+            b.head = new (block) node {b.head};
+            b.count++;
+        } else {
+            ::operator delete(block);
+        }
+    }
+
+    friend class scoped_frame_resource;
+
+   public:
+    /**
+     * @brief Frame sizes are rounded up to a multiple of granularity. Frames
+     * larger than bucket_count * granularity bypass the pool.
+     */
+    constexpr static size_t granularity = 64;
+    /**
+     * @brief The maximum number of free frames cached per bucket, per thread
+     */
+    constexpr static size_t max_cached = 64;
+
+    frame_pool(frame_pool const&) = delete;
+    frame_pool& operator=(frame_pool const&) = delete;
+
+    /**
+     * @brief Returns the pool belonging to the current thread
+     */
+    static frame_pool& local() noexcept {
+        thread_local frame_pool pool;
+        return pool;
+    }
+
+    /**
+     * @brief Allocates a coroutine frame of the given size
+     */
+    static void* allocate(size_t size) {
+        frame_pool& pool = local();
+        size_t total = size + header_size;
+        std::pmr::memory_resource* res = pool.resource;
+        void* block = res ? res->allocate(total, header_size)
+                          : pool.allocate_block(total);
+        ::new (block) std::pmr::memory_resource*(res);
+        return static_cast<char*>(block) + header_size;
+    }
+    /**
+     * @brief Frees a coroutine frame previously obtained from allocate()
+     */
+    static void deallocate(void* frame, size_t size) noexcept {
+        void* block = static_cast<char*>(frame) - header_size;
+        size_t total = size + header_size;
+        if (auto* res = *static_cast<std::pmr::memory_resource**>(block)) {
+            res->deallocate(block, total, header_size);
+        } else {
+            local().deallocate_block(block, total);
+        }
+    }
+};
+
+/**
+ * @brief Installs a memory resource (such as a std::pmr::monotonic_buffer_resource
+ * used as an arena) from which coroutine frames on the current thread will be
+ * allocated for the lifetime of this object. The previously installed resource
+ * is restored on destruction. Passing nullptr selects the frame pool.
+ */
+class scoped_frame_resource {
+    std::pmr::memory_resource* previous;
+
+   public:
+    explicit scoped_frame_resource(std::pmr::memory_resource* res) noexcept
+      : previous(frame_pool::local().resource) {
+        frame_pool::local().resource = res;
+    }
+    scoped_frame_resource(scoped_frame_resource const&) = delete;
+    scoped_frame_resource& operator=(scoped_frame_resource const&) = delete;
+    ~scoped_frame_resource() { frame_pool::local().resource = previous; }
+};
+
+/**
+ * @brief Base class for promise types whose coroutine frames should be
+ * allocated via noam::frame_pool
+ */
+struct pooled_frame {
+    static void* operator new(size_t size) {
+        return frame_pool::allocate(size);
+    }
+    static void operator delete(void* frame, size_t size) noexcept {
+        frame_pool::deallocate(frame, size);
+    }
+};
+
+/**
+ * @brief Base class for promise types that use the default frame allocation
+ */
+struct default_frame {};
+
+/**
+ * @brief The base class used by noam's promise types to select how coroutine
+ * frames are allocated. Controlled by NOAM_COROUTINE_FRAME_POOL.
+ */
+#if NOAM_COROUTINE_FRAME_POOL
+using frame_allocation = pooled_frame;
+#else
+using frame_allocation = default_frame;
+#endif
+} // namespace noam
@@ -80,6 +80,41 @@ constexpr bool parse_assign_value(state_t& st, P const& p, Value& v) // <br>
         }
     }
 }
+
+/**
+ * @brief Parses a list of elements separated by `sep`, passing the value of
+ * each element to `out`. Stops before a separator which isn't followed by an
+ * element.
+ *
+ * @param elem parses each element
+ * @param sep parses the separator between elements
+ * @param st the state
+ * @param out called with the value of each element, in order
+ * @return state_t the state after the last element, or `st` if there were no
+ * elements
+ */
+template <class Elem, class Sep, class Out>
+constexpr state_t parse_elements(
+    Elem const& elem,
+    Sep const& sep,
+    state_t st,
+    Out&& out) {
+    auto first = elem.parse(st);
+    if (!first) {
+        return st;
+    }
+    st = first.get_state();
+    out(std::move(first).get_value());
+    while (auto sep_result = sep.parse(st)) {
+        auto next = elem.parse(sep_result.get_state());
+        if (!next) {
+            break;
+        }
+        st = next.get_state();
+        out(std::move(next).get_value());
+    }
+    return st;
+}
 } // namespace noam
 
 namespace noam::meta::impl {
@@ -104,6 +139,11 @@ struct all_but_last<List, A, B...> {
         type;
 };
 
+template <class A, class...>
+struct first {
+    using type = A;
+};
+
 template <class, class... B>
 struct last {
     using type = typename last<B...>::type;
@@ -122,6 +162,9 @@ template <template <class...> class List, class... T>
 using all_but_last_t = typename ::noam::meta::impl::all_but_last<List, T...>::
     type;
 
+template <class... T>
+using first_t = typename ::noam::meta::impl::first<T...>::type;
+
 template <class... T>
 using last_t = typename ::noam::meta::impl::last<T...>::type;
 } // namespace noam::meta
@@ -1,49 +1,95 @@
 #pragma once
 #include <charconv>
 #include <cstddef>
+#include <cstring>
+#include <functional>
 #include <noam/operators.hpp>
+#include <noam/padded.hpp>
 #include <noam/parser.hpp>
 #include <noam/result_types.hpp>
+#include <noam/util/char_class.hpp>
 #include <noam/util/combinator_types.hpp>
+#include <noam/util/cow_string.hpp>
+#include <noam/util/decimal.hpp>
+#include <noam/util/first_set.hpp>
+#include <noam/util/floating.hpp>
 #include <noam/util/literal.hpp>
+#include <noam/util/literal_trie.hpp>
+#include <noam/util/partial_input.hpp>
+#include <noam/util/simd.hpp>
+#include <noam/util/unescape.hpp>
+#include <span>
 #include <string>
 
-#ifdef _LIBCPP_VERSION
-#include <fast_float/fast_float.h>
-#endif
-
 namespace noam::parsers {
+static_assert(
+    input_padding >= simd::width,
+    "Padded input must be able to hold an entire SIMD block");
+
+/**
+ * @brief The bytes a number of type T can start with, when written in the
+ * given format. The general format accepts "inf" and "nan" in any case, but
+ * not a leading '+'.
+ */
+template <class T, number_format format = number_format::general>
+constexpr char_class number_first_set() noexcept {
+    char_class result = char_classes::digit;
+    if constexpr (std::is_signed_v<T> || std::is_floating_point_v<T>) {
+        result.insert('-');
+    }
+    if constexpr (
+        std::is_floating_point_v<T> && format == number_format::general) {
+        result = result | char_class::of(".iInN");
+    }
+    return result;
+}
+
+/**
+ * @brief Notes the end of the input if a number parsed from [begin, end)
+ * could change were the input to continue. Integers can only be extended by another digit (or
+ * completed, if all that's there is a sign). A float could be extended by
+ * its exponent, or the rest of "infinity", so any float stopping within a
+ * few bytes of the end is treated as though it may change.
+ *
+ * @param stop where the number stopped, or nullptr if it didn't parse
+ */
+template <class T>
+constexpr void note_number_end(
+    char const* begin,
+    char const* stop,
+    char const* end) noexcept {
+    constexpr ptrdiff_t reach = std::is_floating_point_v<T> ? 9 : 1;
+    char const* from = stop ? stop : begin;
+    if (end - from < reach || (!stop && end - begin <= 1)) {
+        note_end_of_input();
+    }
+}
+
 template <class T>
 struct charconv {
+    constexpr static char_class first_set() noexcept {
+        return number_first_set<T>();
+    }
     auto parse(state_t state) const -> result<T> {
         if constexpr (std::is_floating_point_v<T>) {
-#ifdef _LIBCPP_VERSION
-            using fast_float::from_chars;
-            // // fast_float doesn't support long double
-            using value_t = std::conditional_t< // <br>
-                std::is_same_v<T, long double>, // <br>
-                double,                         // <br>
-                T>;
-#else
-            using std::from_chars;
-            using value_t = T;
-#endif
-            auto start_ = state.data();
             auto end_ = state.data() + state.size();
-            value_t value;
-            auto result = from_chars(start_, end_, value);
-            if (result.ec == std::errc()) {
-                return {state_t(result.ptr, end_), value};
+            T value;
+            char const* ptr = floating::parse(state.data(), end_, value);
+            note_number_end<T>(state.data(), ptr, end_);
+            if (ptr) {
+                return {state_t(ptr, end_), value};
             } else {
                 return {};
             }
         } else {
-            auto start_ = state.data();
+            // Base 10 integers are parsed 8 digits at a time, with the same
+            // syntax and overflow behavior as std::from_chars
             auto end_ = state.data() + state.size();
             T value;
-            auto result = std::from_chars(start_, end_, value);
-            if (result.ec == std::errc()) {
-                return {state_t(result.ptr, end_), value};
+            char const* ptr = decimal::parse(state.data(), end_, value);
+            note_number_end<T>(state.data(), ptr, end_);
+            if (ptr) {
+                return {state_t(ptr, end_), value};
             } else {
                 return {};
             }
@@ -51,6 +97,58 @@ struct charconv {
     }
 };
 
+/**
+ * @brief Parses a floating point number using the given grammar
+ *
+ * @tparam T float, double, or long double
+ * @tparam format the grammar to accept
+ */
+template <class T, number_format format>
+struct floating_point {
+    static_assert(
+        std::is_floating_point_v<T>,
+        "floating_point requires a float");
+    constexpr static char_class first_set() noexcept {
+        return number_first_set<T, format>();
+    }
+    auto parse(state_t state) const -> result<T> {
+        auto end_ = state.data() + state.size();
+        T value;
+        char const* ptr = floating::parse<T, format>(state.data(), end_, value);
+        note_number_end<T>(state.data(), ptr, end_);
+        if (ptr) {
+            return {state_t(ptr, end_), value};
+        } else {
+            return {};
+        }
+    }
+};
+
+/**
+ * @brief Parses a base 10 integer which is already known to be valid.
+ * Overflow isn't detected, so out-of-range values wrap.
+ *
+ * @tparam T the integer type to parse
+ */
+template <class T>
+struct unchecked_integer {
+    static_assert(std::is_integral_v<T>, "unchecked_integer requires an int");
+    constexpr static char_class first_set() noexcept {
+        return number_first_set<T>();
+    }
+    auto parse(state_t state) const noexcept -> result<T> {
+        auto end_ = state.data() + state.size();
+        T value;
+        char const* ptr = decimal::parse<T, false>(state.data(), end_, value);
+        note_number_end<T>(state.data(), ptr, end_);
+        if (ptr) {
+            return {state_t(ptr, end_), value};
+        } else {
+            return {};
+        }
+    }
+};
+
 /**
  * @brief Checks if a string is prefixed by any literal in the sequence. If
  * true, removes the prefix. The result is the empty type.
@@ -59,8 +157,18 @@ struct charconv {
  */
 template <any_literal... Literals>
 struct literal {
+    constexpr static std::optional<char_class> first_set() noexcept {
+        return literal_first_set<Literals...>();
+    }
     constexpr auto parse(state_t st) const -> result<empty> {
-        if ((Literals.check_and_update(st) || ...)) {
+        if (check_any_and_update<Literals...>(st)) {
+            return {st, empty {}};
+        } else {
+            return {};
+        }
+    }
+    auto parse(padded_state st) const -> result<empty> {
+        if (check_any_and_update<Literals...>(st)) {
             return {st, empty {}};
         } else {
             return {};
@@ -77,8 +185,18 @@ struct literal {
  */
 template <class T, any_literal... Literals>
 struct literal_makes {
+    constexpr static std::optional<char_class> first_set() noexcept {
+        return literal_first_set<Literals...>();
+    }
     constexpr auto parse(state_t st) const -> result<T> {
-        if ((Literals.check_and_update(st) || ...)) {
+        if (check_any_and_update<Literals...>(st)) {
+            return {st, T {}};
+        } else {
+            return {};
+        }
+    }
+    auto parse(padded_state st) const -> result<T> {
+        if (check_any_and_update<Literals...>(st)) {
             return {st, T {}};
         } else {
             return {};
@@ -96,8 +214,18 @@ struct literal_makes {
 template <auto constant, any_literal... Literals>
 struct literal_constant {
     using T = std::decay_t<decltype(constant)>;
+    constexpr static std::optional<char_class> first_set() noexcept {
+        return literal_first_set<Literals...>();
+    }
     constexpr auto parse(state_t st) const -> result<T> {
-        if ((Literals.check_and_update(st) || ...)) {
+        if (check_any_and_update<Literals...>(st)) {
+            return {st, constant};
+        } else {
+            return {};
+        }
+    }
+    auto parse(padded_state st) const -> result<T> {
+        if (check_any_and_update<Literals...>(st)) {
             return {st, constant};
         } else {
             return {};
@@ -110,15 +238,36 @@ struct zero_or_more_chars {
     constexpr auto parse(state_t state) const noexcept -> pure_result<empty> {
         char const* begin = state._begin;
         char const* end = state._end;
-        while (begin < end && ((*begin == chars) || ...))
-            begin++;
+        if (!std::is_constant_evaluated()) {
+            begin = simd::skip<chars...>(begin, end);
+        } else {
+            while (begin < end && ((*begin == chars) || ...))
+                begin++;
+        }
+        if (begin == end) {
+            note_end_of_input();
+        }
         return {state_t {begin, end}, empty {}};
     }
+    auto parse(padded_state state) const noexcept -> pure_result<empty> {
+        char const* end = state._end;
+        return {
+            state_t {simd::skip_padded<chars...>(state._begin, end), end},
+            empty {}};
+    }
 };
 
 template <char... chars>
 struct count_chars {
     constexpr auto parse(state_t state) const noexcept -> pure_result<size_t> {
+        if (!std::is_constant_evaluated()) {
+            char const* end = state._end;
+            char const* stop = simd::skip<chars...>(state._begin, end);
+            if (stop == end) {
+                note_end_of_input();
+            }
+            return {state_t {stop, end}, size_t(stop - state._begin)};
+        }
         size_t size = state.size();
         size_t i = 0;
         for (; i < size; i++) {
@@ -130,65 +279,124 @@ struct count_chars {
 
             break;
         }
+        if (i == size) {
+            note_end_of_input();
+        }
         state.remove_prefix(i);
         return noam::pure_result {state, i};
     }
+    auto parse(padded_state state) const noexcept -> pure_result<size_t> {
+        char const* end = state._end;
+        char const* stop = simd::skip_padded<chars...>(state._begin, end);
+        return {state_t {stop, end}, size_t(stop - state._begin)};
+    }
 };
 
-struct bool_parser {
-    constexpr auto parse(state_t st) const noexcept -> result<bool> {
-        if (st.starts_with("true")) {
-            return {st.substr(4), true};
+/**
+ * @brief Parses a single character in the class `cls`, and returns it
+ */
+template <char_class cls>
+struct one_of {
+    constexpr static char_class first_set() noexcept { return cls; }
+    constexpr auto parse(state_t state) const noexcept -> result<char> {
+        if (state.empty()) {
+            note_end_of_input();
+            return {};
         }
-        if (st.starts_with("false")) {
-            return {st.substr(5), false};
+        if (!cls.contains(state[0])) {
+            return {};
         }
-        return {};
+        return {state_t {state._begin + 1, state._end}, state[0]};
     }
 };
 
-struct string_parser {
-    auto parse(state_t st) const -> result<std::string> {
-        if (st.size() >= 2 && st[0] == '"') {
-            std::string str;
-            size_t i = 1;
-            size_t count = st.size() - 1;
-            while (i < count) {
-                char c = st[i];
-                char val = c;
-                if (c == '\\') {
-                    char next = st[i + 1];
-                    switch (next) {
-                        case 'b': val = '\b'; break;
-                        case 'f': val = '\f'; break;
-                        case 'n': val = '\n'; break;
-                        case 'r': val = '\r'; break;
-                        case 't': val = '\t'; break;
-                        case '\\': val = '\\'; break;
-                        case '"': val = '"'; break;
-                        // The parser fails on an unrecognized escape code
-                        default: return {};
-                    }
-                    i += 2;
-                } else if (c == '"') {
-                    break;
-                } else {
-                    val = c;
-                    i += 1;
-                }
-                str.push_back(val);
-            }
-            if (st[i] == '"') {
-                return {st.substr(i + 1), std::move(str)};
+/**
+ * @brief Parses zero or more characters in the class `cls`, and returns them
+ * as a string_view
+ */
+template <char_class cls>
+struct many_of {
+    /**
+     * @brief Returns the first position in [begin, end) which isn't in cls
+     */
+    constexpr static char const* skip(
+        char const* begin,
+        char const* end) noexcept {
+        if (!std::is_constant_evaluated()) {
+            begin = simd::skip_class<cls>(begin, end);
+        } else {
+            while (begin < end && cls.contains(*begin)) {
+                begin++;
             }
-        } // namespace noam::parsers
+        }
+        if (begin == end) {
+            note_end_of_input();
+        }
+        return begin;
+    }
+    constexpr auto parse(state_t state) const noexcept
+        -> pure_result<std::string_view> {
+        char const* stop = skip(state._begin, state._end);
+        return {
+            state_t {stop, state._end},
+            std::string_view(state._begin, stop - state._begin)};
+    }
+};
+
+/**
+ * @brief Parses a character in `first`, followed by any number of
+ * characters in `rest`, and returns them as a string_view
+ */
+template <char_class first, char_class rest>
+struct identifier_parser {
+    constexpr static char_class first_set() noexcept { return first; }
+    constexpr auto parse(state_t state) const noexcept
+        -> result<std::string_view> {
+        if (state.empty()) {
+            note_end_of_input();
+            return {};
+        }
+        if (!first.contains(state[0])) {
+            return {};
+        }
+        char const* stop = many_of<rest>::skip(state._begin + 1, state._end);
+        return {
+            state_t {stop, state._end},
+            std::string_view(state._begin, stop - state._begin)};
+    }
+};
+
+struct bool_parser {
+    constexpr static string_literal<4> true_literal = "true";
+    constexpr static string_literal<5> false_literal = "false";
+    constexpr static char_class first_set() noexcept {
+        return char_class::of("tf");
+    }
+    constexpr auto parse(state_t st) const noexcept -> result<bool> {
+        if (true_literal.check_and_update(st)) {
+            return {st, true};
+        }
+        if (false_literal.check_and_update(st)) {
+            return {st, false};
+        }
+        return {};
+    }
+    auto parse(padded_state st) const noexcept -> result<bool> {
+        if (true_literal.check_and_update(st)) {
+            return {st, true};
+        }
+        if (false_literal.check_and_update(st)) {
+            return {st, false};
+        }
         return {};
     }
 };
 
 /**
  * @brief Parses a segment of characters between a beginning delimiter and an
- * ending delimiter as a string view
+ * ending delimiter as a string view. An escape sequence escapes the character
+ * that follows it, so an escaped delimiter doesn't end the view (and an
+ * escaped escape doesn't escape the delimiter after it).
  *
  * @tparam begin
  * @tparam end
@@ -197,9 +405,22 @@ struct string_parser {
 template <any_literal begin, any_literal end, any_literal escape>
 struct view_parser {
     constexpr static size_t min_length = begin.size() + end.size();
+    // If the end delimiter and the escape are single characters, the view is
+    // found with a vectorized scan for either of them
+    constexpr static bool scan_for_chars = end.size() == 1
+                                        && escape.size() == 1;
+    constexpr static std::optional<char_class> first_set() noexcept {
+        return literal_first_set<begin>();
+    }
+
     constexpr auto parse(state_t st) const -> result<std::string_view> {
         if (begin.check_and_update(st)) {
             char const* view_begin = st.data();
+            if constexpr (scan_for_chars) {
+                if (!std::is_constant_evaluated()) {
+                    return scan(view_begin, st.end());
+                }
+            }
             while (st.size() > 0) {
                 char const* view_end = st.data();
                 if (end.check_and_update(st)) [[unlikely]] {
@@ -208,19 +429,176 @@ struct view_parser {
                         std::string_view(view_begin, view_end - view_begin)};
                 }
                 if (escape.check_and_update(st)) [[unlikely]] {
-                    end.check_and_update(st);
-                } else {
-                    st.remove_prefix(1);
+                    if (st.empty()) {
+                        break;
+                    }
                 }
+                st.remove_prefix(1);
             }
+            // The view wasn't closed before the end of the input
+            note_end_of_input();
         }
         return {};
     }
+
+   private:
+    static auto scan(char const* view_begin, char const* input_end)
+        -> result<std::string_view> {
+        constexpr char end_ch = end.view()[0];
+        constexpr char escape_ch = escape.view()[0];
+        char const* pos = view_begin;
+        for (;;) {
+            pos = simd::find_any<end_ch, escape_ch>(pos, input_end);
+            if (pos == input_end) {
+                note_end_of_input();
+                return {};
+            }
+            if (*pos == end_ch) {
+                return {
+                    state_t(pos + 1, input_end),
+                    std::string_view(view_begin, pos - view_begin)};
+            }
+            // Skip the escape, and the character it escapes
+            if (input_end - pos < 2) {
+                note_end_of_input();
+                return {};
+            }
+            pos += 2;
+        }
+    }
+};
+
+/**
+ * @brief Parses a quoted string, decoding any escape sequences (including
+ * `\uXXXX` escapes, which are written as UTF-8). The closing quote is found
+ * first, so that the string can be reserved once, and then unescaped runs of
+ * characters are copied in bulk.
+ *
+ */
+struct string_parser {
+    constexpr static char_class first_set() noexcept {
+        return char_class::of("\"");
+    }
+    auto parse(state_t st) const -> result<std::string> {
+        auto view = view_parser<'"', '"', '\\'> {}.parse(st);
+        if (!view) {
+            return {};
+        }
+        std::string_view raw = view.get_value();
+        // Escapes never decode to more bytes than they take up, so the
+        // result fits in raw.size() bytes
+        std::string str(raw.size(), '\0');
+        char* out = unescape::decode_string(
+            raw.data(),
+            raw.data() + raw.size(),
+            str.data());
+        if (!out) {
+            return {};
+        }
+        str.resize(out - str.data());
+        return {view.get_state(), std::move(str)};
+    }
+};
+
+/**
+ * @brief Parses a quoted string as a cow_string. If the string contains no
+ * escape sequences, the result refers to the input. Otherwise, the string is
+ * decoded into a new allocation.
+ *
+ */
+struct cow_string_parser {
+    constexpr static char_class first_set() noexcept {
+        return char_class::of("\"");
+    }
+    auto parse(state_t st) const -> result<cow_string> {
+        auto view = view_parser<'"', '"', '\\'> {}.parse(st);
+        if (!view) {
+            return {};
+        }
+        std::string_view raw = view.get_value();
+        char const* end = raw.data() + raw.size();
+        if (simd::find(raw.data(), end, '\\') == end) {
+            return {view.get_state(), cow_string(raw)};
+        }
+        std::string str(raw.size(), '\0');
+        char* out = unescape::decode_string(raw.data(), end, str.data());
+        if (!out) {
+            return {};
+        }
+        str.resize(out - str.data());
+        return {view.get_state(), cow_string(std::move(str))};
+    }
+};
+
+/**
+ * @brief Parses a quoted string, decoding escape sequences in place. The
+ * input must lie within `buffer`, which the decoded string is written back
+ * into, so no allocation is needed. The result refers to the buffer.
+ *
+ * Only the region between the quotes is overwritten, so the rest of the input
+ * is unaffected, and the string is checked for invalid escapes before any of
+ * it is written, so a string which fails to parse is left as it was. Strings
+ * without escapes are never written to.
+ *
+ * A string with escapes can only be parsed once: after it's been decoded,
+ * parsing it again reads the decoded text. Don't use this parser where a
+ * combinator may backtrack over a string it has already parsed.
+ *
+ */
+struct insitu_string_parser {
+    std::span<char> buffer;
+    constexpr static char_class first_set() noexcept {
+        return char_class::of("\"");
+    }
+    auto parse(state_t st) const -> result<std::string_view> {
+        auto view = view_parser<'"', '"', '\\'> {}.parse(st);
+        if (!view) {
+            return {};
+        }
+        std::string_view raw = view.get_value();
+        std::less<char const*> less;
+        if (less(raw.data(), buffer.data())
+            || less(buffer.data() + buffer.size(), raw.data() + raw.size())) {
+            return {};
+        }
+        char const* end = raw.data() + raw.size();
+        if (!unescape::validate_string(raw.data(), end)) {
+            return {};
+        }
+        char* begin = buffer.data() + (raw.data() - buffer.data());
+        char* out = unescape::decode_string(raw.data(), end, begin);
+        return {view.get_state(), std::string_view(begin, out - begin)};
+    }
 };
 
 struct line_parser {
+    /**
+     * @brief Splits off the line ending at `newline` (which is `end` if the
+     * input has no newline). A carriage return before the newline isn't
+     * included in the line.
+     */
+    constexpr static auto split_at(
+        char const* begin,
+        char const* newline,
+        char const* end) noexcept -> noam::pure_result<std::string_view> {
+        if (newline == end) {
+            note_end_of_input();
+            return {state_t {end, end}, std::string_view(begin, end - begin)};
+        }
+        char const* line_end = newline;
+        if (line_end > begin && line_end[-1] == '\r') {
+            line_end--;
+        }
+        return {
+            state_t {newline + 1, end},
+            std::string_view(begin, line_end - begin)};
+    }
     constexpr auto parse(state_t state) const
         -> noam::pure_result<std::string_view> {
+        if (!std::is_constant_evaluated()) {
+            char const* newline = simd::find(state._begin, state._end, '\n');
+            return split_at(state._begin, newline, state._end);
+        }
         size_t size = state.size();
         for (size_t i = 0; i < size; i++) {
             char current = state[i];
@@ -237,7 +615,13 @@ struct line_parser {
             }
             return {state.substr(i + 1), state.substr(0, line_size)};
         }
+        note_end_of_input();
         return {state.substr(size), state};
     };
+    auto parse(padded_state state) const noexcept
+        -> noam::pure_result<std::string_view> {
+        char const* newline = simd::find_padded(state._begin, state._end, '\n');
+        return split_at(state._begin, newline, state._end);
+    }
 };
 } // namespace noam::parsers
@@ -1,6 +1,12 @@
 #pragma once
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <noam/padded.hpp>
 #include <noam/state.hpp>
+#include <noam/util/partial_input.hpp>
 #include <string_view>
+#include <type_traits>
 
 namespace noam {
 template <size_t N>
@@ -15,12 +21,94 @@ struct string_literal {
         }
     }
     constexpr size_t size() const noexcept { return N; }
+    constexpr std::string_view view() const noexcept { return {str, N}; }
+    /**
+     * @brief The smallest unsigned word that holds the literal. Literals of
+     * up to 8 bytes are compared against the input a word at a time.
+     */
+    using word_t = std::conditional_t<(N <= 4), uint32_t, uint64_t>;
+    constexpr static bool word_sized = N > 0 && N <= sizeof(uint64_t);
+
+    /**
+     * @brief The literal packed into a word, laid out the way a word loaded
+     * from memory would be. Bytes past the end of the literal are 0.
+     */
+    constexpr word_t word() const noexcept {
+        word_t result = 0;
+        for (size_t i = 0; i < N && i < sizeof(word_t); i++) {
+            size_t byte = std::endian::native == std::endian::little
+                            ? i
+                            : sizeof(word_t) - 1 - i;
+            result |= word_t((unsigned char)str[i]) << (8 * byte);
+        }
+        return result;
+    }
+    /**
+     * @brief Selects the bytes of a loaded word which hold the literal
+     */
+    constexpr static word_t word_mask() noexcept {
+        if constexpr (N >= sizeof(word_t)) {
+            return ~word_t(0);
+        } else if constexpr (std::endian::native == std::endian::little) {
+            return (word_t(1) << (8 * N)) - 1;
+        } else {
+            return ~(~word_t(0) >> (8 * N));
+        }
+    }
+    /**
+     * @brief Compares the first sizeof(word_t) bytes at `data` against the
+     * literal. The caller must ensure that many bytes may be read.
+     */
+    bool word_matches(char const* data) const noexcept {
+        word_t input;
+        std::memcpy(&input, data, sizeof(word_t));
+        return (input & word_mask()) == word();
+    }
+
     constexpr bool check_and_update(state_t& st) const noexcept {
+        if constexpr (word_sized) {
+            // Near the end of the input a whole word can't be loaded, so
+            // the bytes are compared one at a time instead
+            if (!std::is_constant_evaluated()
+                && st.size() >= intptr_t(sizeof(word_t))) {
+                if (word_matches(st.data())) {
+                    st.remove_prefix(N);
+                    return true;
+                }
+                return false;
+            }
+        }
         if (st.starts_with(std::string_view(str, N))) {
             st.remove_prefix(N);
             return true;
-        } else {
+        }
+        // The input may be the start of the literal, cut off
+        if (st.size() < intptr_t(N) && state_t(view()).starts_with(st)) {
+            note_end_of_input();
+        }
+        return false;
+    }
+    /**
+     * @brief Checks for the literal at the start of padded input. All N bytes
+     * are compared before the length is checked, so the comparison can be
+     * done a word at a time.
+     */
+    bool check_and_update(padded_state& st) const noexcept {
+        if constexpr (word_sized) {
+            if (word_matches(st.data()) && st.size() >= intptr_t(N)) {
+                st.remove_prefix(N);
+                return true;
+            }
+            return false;
+        } else if constexpr (N <= input_padding) {
+            if (std::memcmp(st.data(), str, N) == 0
+                && st.size() >= intptr_t(N)) {
+                st.remove_prefix(N);
+                return true;
+            }
             return false;
+        } else {
+            return check_and_update(static_cast<state_t&>(st));
         }
     }
 };
@@ -35,18 +123,22 @@ struct char_literal {
     constexpr char_literal(char ch) noexcept
       : ch(ch) {}
     constexpr size_t size() const noexcept { return 1; }
+    constexpr std::string_view view() const noexcept { return {&ch, 1}; }
     constexpr bool check_and_update(state_t& st) const noexcept {
         if (st.starts_with(ch)) {
             st.remove_prefix(1);
             return true;
-        } else {
-            return false;
         }
+        if (st.empty()) {
+            note_end_of_input();
+        }
+        return false;
     }
 };
 
 struct empty_literal {
     constexpr size_t size() const noexcept { return 0; }
+    constexpr std::string_view view() const noexcept { return {}; }
     constexpr bool check_and_update(state_t& st) const noexcept { return true; }
 };
 
@@ -55,6 +147,7 @@ struct any_literal : Base {
     using Base::Base;
     using Base::check_and_update;
     using Base::size;
+    using Base::view;
     any_literal() = default;
     any_literal(any_literal const&) = default;
     any_literal(any_literal&&) = default;
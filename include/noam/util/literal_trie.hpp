@@ -0,0 +1,214 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <noam/state.hpp>
+#include <noam/util/literal.hpp>
+#include <noam/util/partial_input.hpp>
+#include <string_view>
+
+namespace noam {
+/**
+ * @brief A trie of literals, built at compile time. Finding which literal
+ * matches the input takes time proportional to the length of the literal,
+ * rather than the number of literals.
+ *
+ * Matching follows ordered choice, the same as trying each literal in turn:
+ * if several literals are prefixes of the input, the first one in the list
+ * wins, even if it's shorter.
+ *
+ * @tparam LiteralCount the number of literals
+ * @tparam MaxNodes an upper bound on the number of nodes (1 + the total
+ * length of the literals)
+ */
+template <size_t LiteralCount, size_t MaxNodes>
+struct literal_trie {
+    constexpr static uint16_t no_match = 0xffff;
+    static_assert(
+        LiteralCount < no_match && MaxNodes < no_match,
+        "Too many literals for literal_trie");
+
+    struct node {
+        // The range of this node's edges in edge_chars and edge_targets
+        uint16_t first_edge = 0;
+        uint16_t edge_count = 0;
+        // The index of the literal ending at this node, if any
+        uint16_t match = no_match;
+        // The lowest index of any literal ending below this node. Once this
+        // is greater than the best match so far, the search can stop.
+        uint16_t min_below = no_match;
+    };
+
+    std::array<node, MaxNodes> nodes {};
+    std::array<char, MaxNodes> edge_chars {};
+    std::array<uint16_t, MaxNodes> edge_targets {};
+    // The children of the root, indexed by byte (0 if there isn't one)
+    std::array<uint16_t, 256> root_children {};
+
+    /**
+     * @brief Builds the trie. Nodes are the distinct prefixes of the
+     * literals, sorted so that the edges leaving each node are contiguous
+     * and ordered by character.
+     */
+    constexpr literal_trie(
+        std::array<std::string_view, LiteralCount> const& literals) {
+        // The root is the empty prefix, and each literal adds one prefix for
+        // each of its characters (many of which will be duplicates)
+        std::array<std::string_view, MaxNodes> prefixes {};
+        size_t node_count = 1;
+        for (auto literal : literals) {
+            for (size_t i = 1; i <= literal.size(); i++) {
+                prefixes[node_count++] = literal.substr(0, i);
+            }
+        }
+        auto by_bytes = [](std::string_view a, std::string_view b) {
+            return std::lexicographical_compare(
+                a.begin(),
+                a.end(),
+                b.begin(),
+                b.end(),
+                [](char x, char y) {
+                    return (unsigned char)x < (unsigned char)y;
+                });
+        };
+        std::sort(prefixes.begin(), prefixes.begin() + node_count, by_bytes);
+        auto unique_end =
+            std::unique(prefixes.begin(), prefixes.begin() + node_count);
+        node_count = unique_end - prefixes.begin();
+        auto index_of = [&](std::string_view prefix) {
+            return uint16_t(
+                std::lower_bound(
+                    prefixes.begin(),
+                    prefixes.begin() + node_count,
+                    prefix,
+                    by_bytes)
+                - prefixes.begin());
+        };
+
+        // Prefixes are sorted, so a node's children are sorted by character.
+        // Edges are grouped by parent by counting them first.
+        for (size_t i = 1; i < node_count; i++) {
+            auto prefix = prefixes[i];
+            nodes[index_of(prefix.substr(0, prefix.size() - 1))].edge_count++;
+        }
+        uint16_t edge = 0;
+        for (size_t i = 0; i < node_count; i++) {
+            nodes[i].first_edge = edge;
+            edge += nodes[i].edge_count;
+            nodes[i].edge_count = 0;
+        }
+        for (size_t i = 1; i < node_count; i++) {
+            auto prefix = prefixes[i];
+            node& parent = nodes[index_of(prefix.substr(0, prefix.size() - 1))];
+            uint16_t slot = parent.first_edge + parent.edge_count++;
+            edge_chars[slot] = prefix.back();
+            edge_targets[slot] = uint16_t(i);
+            if (prefix.size() == 1) {
+                root_children[(unsigned char)prefix.back()] = uint16_t(i);
+            }
+        }
+
+        for (size_t i = 0; i < LiteralCount; i++) {
+            node& end = nodes[index_of(literals[i])];
+            end.match = std::min(end.match, uint16_t(i));
+        }
+        // Children come after their parents, so visiting nodes in reverse
+        // order sees every child before its parent
+        for (size_t i = node_count; i-- > 0;) {
+            node& parent = nodes[i];
+            for (size_t e = 0; e < parent.edge_count; e++) {
+                node const& child = nodes[edge_targets[parent.first_edge + e]];
+                parent.min_below = std::min(
+                    {parent.min_below, child.match, child.min_below});
+            }
+        }
+    }
+
+    constexpr uint16_t child(uint16_t index, char ch) const noexcept {
+        if (index == 0) {
+            return root_children[(unsigned char)ch];
+        }
+        node const& n = nodes[index];
+        for (size_t e = n.first_edge; e < n.first_edge + n.edge_count; e++) {
+            if (edge_chars[e] == ch) {
+                return edge_targets[e];
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Finds the first literal (in the order they were given) which is
+     * a prefix of the input
+     *
+     * @param length set to the length of the literal, if one matches
+     * @return uint16_t the index of the literal, or no_match
+     */
+    constexpr uint16_t find(state_t st, size_t& length) const noexcept {
+        uint16_t best = nodes[0].match;
+        length = 0;
+        uint16_t current = 0;
+        size_t size = st.size();
+        size_t depth = 0;
+        while (depth < size) {
+            if (nodes[current].min_below > best) {
+                return best;
+            }
+            current = child(current, st[depth]);
+            if (current == 0) {
+                return best;
+            }
+            depth++;
+            if (nodes[current].match < best) {
+                best = nodes[current].match;
+                length = depth;
+            }
+        }
+        // The input ran out, so a literal below this node may still match
+        if (nodes[current].min_below < best) {
+            note_end_of_input();
+        }
+        return best;
+    }
+};
+
+/**
+ * @brief The trie for a pack of literals
+ */
+template <any_literal... Literals>
+constexpr literal_trie<sizeof...(Literals), 1 + (Literals.size() + ... + 0)>
+    literal_trie_for {std::array<std::string_view, sizeof...(Literals)> {
+        Literals.view()...}};
+
+/**
+ * @brief Checks if the input starts with any of the literals, and if so,
+ * removes the first one that matches. This is equivalent to
+ * `(Literals.check_and_update(st) || ...)`, but large sets of literals are
+ * searched with a trie.
+ */
+template <any_literal... Literals>
+constexpr bool check_any_and_update(state_t& st) noexcept {
+    // Small sets are quicker to check one at a time
+    if constexpr (sizeof...(Literals) <= 4) {
+        return (Literals.check_and_update(st) || ...);
+    } else {
+        size_t length = 0;
+        auto& trie = literal_trie_for<Literals...>;
+        if (trie.find(st, length) == trie.no_match) {
+            return false;
+        }
+        st.remove_prefix(length);
+        return true;
+    }
+}
+
+template <any_literal... Literals>
+bool check_any_and_update(padded_state& st) noexcept {
+    if constexpr (sizeof...(Literals) <= 4) {
+        return (Literals.check_and_update(st) || ...);
+    } else {
+        return check_any_and_update<Literals...>(static_cast<state_t&>(st));
+    }
+}
+} // namespace noam
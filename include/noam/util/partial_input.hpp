@@ -0,0 +1,82 @@
+#pragma once
+#include <type_traits>
+
+// Reaching the end of the input is rare, so recording it is kept out of line,
+// where it doesn't add to the size of the parsers that call it
+#if defined(__GNUC__)
+#define NOAM_COLD [[gnu::noinline, gnu::cold]]
+#elif defined(_MSC_VER)
+#define NOAM_COLD __declspec(noinline)
+#else
+#define NOAM_COLD
+#endif
+
+namespace noam {
+/**
+ * @brief Marks a parse of input which may not be complete, such as the input
+ * a push_parser has received so far, or a buffer being refilled by
+ * noam::for_each_record. While one is installed on the current thread,
+ * intrinsic parsers record whether their result depended on where the input
+ * ends: a number or run of characters which reached the end, a literal or
+ * word which the remaining input is too short to rule out, and so on. A
+ * parse which didn't reach the end gives the same result however the input
+ * continues.
+ *
+ * ```cpp
+ * noam::partial_input partial;
+ * auto result = parser.parse(input);
+ * if (partial.reached_end()) {
+ *     // The result may change once there's more input
+ * }
+ * ```
+ *
+ * Parsers only report this when they reach the end of their input, so
+ * ordinary parses don't check for a partial_input on any other path. Parsers
+ * written by hand which look at the end of the input directly (rather than
+ * through other parsers) should call noam::note_end_of_input() when they do.
+ */
+class partial_input {
+    partial_input* previous;
+    bool did_reach_end = false;
+
+    static partial_input*& installed() noexcept {
+        thread_local partial_input* input = nullptr;
+        return input;
+    }
+
+   public:
+    partial_input() noexcept
+      : previous(installed()) {
+        installed() = this;
+    }
+    partial_input(partial_input const&) = delete;
+    partial_input& operator=(partial_input const&) = delete;
+    ~partial_input() { installed() = previous; }
+
+    /**
+     * @brief Checks if a parser reached the end of the input since this was
+     * installed
+     */
+    bool reached_end() const noexcept { return did_reach_end; }
+
+    /**
+     * @brief Records that a parser reached the end of the input, against the
+     * partial_input installed on the current thread, if there is one
+     */
+    NOAM_COLD static void note_end() noexcept {
+        if (partial_input* input = installed()) {
+            input->did_reach_end = true;
+        }
+    }
+};
+
+/**
+ * @brief Called by a parser when its result depends on where the input ends
+ * (see noam::partial_input)
+ */
+constexpr void note_end_of_input() noexcept {
+    if (!std::is_constant_evaluated()) {
+        partial_input::note_end();
+    }
+}
+} // namespace noam
@@ -0,0 +1,292 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <noam/util/char_class.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NOAM_SIMD_WIDTH 32
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NOAM_SIMD_WIDTH 16
+#else
+#define NOAM_SIMD_WIDTH 0
+#endif
+
+// Classifying a block with noam::nibble_table needs a byte shuffle, which
+// is available with AVX2 or SSSE3 (but not plain SSE2)
+#if defined(__AVX2__)
+#define NOAM_SIMD_SHUFFLE 1
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define NOAM_SIMD_SHUFFLE 1
+#else
+#define NOAM_SIMD_SHUFFLE 0
+#endif
+
+/**
+ * @brief Helpers for scanning blocks of input with SIMD instructions. AVX2 is
+ * used if it's enabled at compile time, then SSE2, and otherwise a scalar
+ * fallback. None of these are constexpr; parsers which use them must check
+ * std::is_constant_evaluated() first.
+ *
+ */
+namespace noam::simd {
+/**
+ * @brief Number of bytes examined at a time (0 if SIMD isn't available)
+ *
+ */
+constexpr size_t width = NOAM_SIMD_WIDTH;
+
+#if NOAM_SIMD_WIDTH == 32
+using mask_t = uint32_t;
+constexpr mask_t all_bits = 0xffffffff;
+struct block {
+    __m256i value;
+    static block load(char const* ptr) noexcept {
+        return {_mm256_loadu_si256(reinterpret_cast<__m256i const*>(ptr))};
+    }
+    mask_t eq(char ch) const noexcept {
+        return mask_t(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(value, _mm256_set1_epi8(ch))));
+    }
+    template <char... chars>
+    mask_t eq_any() const noexcept {
+        return (eq(chars) | ...);
+    }
+    /**
+     * @brief Returns a mask of the bytes in the class described by table
+     */
+    mask_t in(nibble_table const& table) const noexcept {
+        __m256i lo = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(table.lo)));
+        __m256i hi = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(table.hi)));
+        __m256i nibble = _mm256_set1_epi8(0x0f);
+        __m256i lo_bits = _mm256_shuffle_epi8(
+            lo,
+            _mm256_and_si256(value, nibble));
+        __m256i hi_bits = _mm256_shuffle_epi8(
+            hi,
+            _mm256_and_si256(_mm256_srli_epi16(value, 4), nibble));
+        __m256i outside = _mm256_cmpeq_epi8(
+            _mm256_and_si256(lo_bits, hi_bits),
+            _mm256_setzero_si256());
+        return ~mask_t(_mm256_movemask_epi8(outside));
+    }
+};
+#elif NOAM_SIMD_WIDTH == 16
+using mask_t = uint32_t;
+constexpr mask_t all_bits = 0xffff;
+struct block {
+    __m128i value;
+    static block load(char const* ptr) noexcept {
+        return {_mm_loadu_si128(reinterpret_cast<__m128i const*>(ptr))};
+    }
+    mask_t eq(char ch) const noexcept {
+        return mask_t(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_set1_epi8(ch))));
+    }
+    template <char... chars>
+    mask_t eq_any() const noexcept {
+        return (eq(chars) | ...);
+    }
+#if NOAM_SIMD_SHUFFLE
+    /**
+     * @brief Returns a mask of the bytes in the class described by table
+     */
+    mask_t in(nibble_table const& table) const noexcept {
+        auto lo = _mm_loadu_si128(reinterpret_cast<__m128i const*>(table.lo));
+        auto hi = _mm_loadu_si128(reinterpret_cast<__m128i const*>(table.hi));
+        __m128i nibble = _mm_set1_epi8(0x0f);
+        __m128i lo_bits = _mm_shuffle_epi8(lo, _mm_and_si128(value, nibble));
+        __m128i hi_bits = _mm_shuffle_epi8(
+            hi,
+            _mm_and_si128(_mm_srli_epi16(value, 4), nibble));
+        __m128i outside = _mm_cmpeq_epi8(
+            _mm_and_si128(lo_bits, hi_bits),
+            _mm_setzero_si128());
+        return ~mask_t(_mm_movemask_epi8(outside)) & all_bits;
+    }
+#endif
+};
+#endif
+
+/**
+ * @brief Returns the index of the lowest set bit in a non-zero mask
+ */
+inline int lowest_bit(uint32_t mask) noexcept { return std::countr_zero(mask); }
+
+/**
+ * @brief Finds the first occurrence of ch in [begin, end), or returns end
+ */
+inline char const* find(char const* begin, char const* end, char ch) noexcept {
+    if (begin == end) {
+        return end;
+    }
+    void const* pos = std::memchr(begin, ch, end - begin);
+    return pos ? static_cast<char const*>(pos) : end;
+}
+
+/**
+ * @brief Finds the first position in [begin, end) holding one of chars...,
+ * or returns end
+ */
+template <char... chars>
+char const* find_any(char const* begin, char const* end) noexcept {
+#if NOAM_SIMD_WIDTH
+    for (; size_t(end - begin) >= width; begin += width) {
+        if (mask_t mask = block::load(begin).template eq_any<chars...>()) {
+            return begin + lowest_bit(mask);
+        }
+    }
+#endif
+    while (begin < end && !((*begin == chars) || ...)) {
+        begin++;
+    }
+    return begin;
+}
+
+/**
+ * @brief Invokes func(char const*) on every occurrence of ch in [begin, end),
+ * in order.
+ */
+template <class Func>
+void for_each(char const* begin, char const* end, char ch, Func&& func) {
+#if NOAM_SIMD_WIDTH
+    for (; size_t(end - begin) >= width; begin += width) {
+        mask_t mask = block::load(begin).eq(ch);
+        while (mask) {
+            func(begin + lowest_bit(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; begin != end; begin++) {
+        if (*begin == ch) {
+            func(begin);
+        }
+    }
+}
+
+/**
+ * @brief Returns the first position in [begin, end) holding a character
+ * that isn't in cls, or end if there isn't one. Long runs are classified a
+ * block at a time using the class's nibble tables, if the class has exact
+ * tables and byte shuffles are available.
+ */
+template <char_class cls>
+char const* skip_class(char const* begin, char const* end) noexcept {
+    static constexpr std::array<bool, 256> in_class = cls.table();
+    for (int i = 0; i < 8; i++, begin++) {
+        if (begin == end || !in_class[(unsigned char)*begin]) {
+            return begin;
+        }
+    }
+#if NOAM_SIMD_WIDTH && NOAM_SIMD_SHUFFLE
+    constexpr nibble_table table = cls.nibbles();
+    if constexpr (table.exact) {
+        for (; size_t(end - begin) >= width; begin += width) {
+            mask_t mask = ~block::load(begin).in(table) & all_bits;
+            if (mask) {
+                return begin + lowest_bit(mask);
+            }
+        }
+    }
+#endif
+    while (begin < end && in_class[(unsigned char)*begin]) {
+        begin++;
+    }
+    return begin;
+}
+
+/**
+ * @brief Returns the first position in [begin, end) holding a character
+ * that isn't one of chars..., or end if there isn't one.
+ */
+template <char... chars>
+char const* skip(char const* begin, char const* end) noexcept {
+    if constexpr (sizeof...(chars) > 8) {
+        // Large sets are checked with a table lookup instead of a compare
+        // per character
+        constexpr char_class cls = [] {
+            char_class result;
+            (result.insert(chars), ...);
+            return result;
+        }();
+        return skip_class<cls>(begin, end);
+    }
+    // Runs are usually short (such as the space after a comma), so the first
+    // few bytes are checked one at a time before switching to blocks
+    for (int i = 0; i < 8; i++, begin++) {
+        if (begin == end || !((*begin == chars) || ...)) {
+            return begin;
+        }
+    }
+#if NOAM_SIMD_WIDTH
+    for (; size_t(end - begin) >= width; begin += width) {
+        mask_t mask = ~block::load(begin).template eq_any<chars...>()
+                    & all_bits;
+        if (mask) {
+            return begin + lowest_bit(mask);
+        }
+    }
+#endif
+    while (begin < end && ((*begin == chars) || ...)) {
+        begin++;
+    }
+    return begin;
+}
+
+/**
+ * @brief Like skip, but reads whole blocks without checking for the end of
+ * the input, so up to 64 bytes past end must be readable (see
+ * noam::padded_state).
+ */
+template <char... chars>
+char const* skip_padded(char const* begin, char const* end) noexcept {
+#if NOAM_SIMD_WIDTH
+    for (; begin < end; begin += width) {
+        mask_t mask = ~block::load(begin).template eq_any<chars...>()
+                    & all_bits;
+        if (mask) {
+            begin += lowest_bit(mask);
+            break;
+        }
+    }
+#else
+    for (; begin < end; begin += 8) {
+        for (int i = 0; i < 8; i++) {
+            if (!((begin[i] == chars) || ...)) {
+                begin += i;
+                return begin < end ? begin : end;
+            }
+        }
+    }
+#endif
+    return begin < end ? begin : end;
+}
+
+/**
+ * @brief Finds the first occurrence of ch in [begin, end), or returns end.
+ * Like skip_padded, up to 64 bytes past end must be readable.
+ */
+inline char const* find_padded(
+    char const* begin,
+    char const* end,
+    char ch) noexcept {
+#if NOAM_SIMD_WIDTH
+    for (; begin < end; begin += width) {
+        if (mask_t mask = block::load(begin).eq(ch)) {
+            begin += lowest_bit(mask);
+            break;
+        }
+    }
+    return begin < end ? begin : end;
+#else
+    return find(begin, end, ch);
+#endif
+}
+} // namespace noam::simd
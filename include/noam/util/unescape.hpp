@@ -0,0 +1,178 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <noam/util/simd.hpp>
+
+/**
+ * @brief Helpers for decoding JSON-style escape sequences, shared by the
+ * string parsers. Decoded output is never longer than the escape sequence it
+ * came from, so output can be written over the input it's decoded from.
+ *
+ */
+namespace noam::unescape {
+/**
+ * @brief Returns the value of a hexadecimal digit, or -1 if ch isn't one
+ */
+constexpr int hex_value(char ch) noexcept {
+    if ('0' <= ch && ch <= '9')
+        return ch - '0';
+    if ('a' <= ch && ch <= 'f')
+        return ch - 'a' + 10;
+    if ('A' <= ch && ch <= 'F')
+        return ch - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Reads 4 hex digits starting at pos. Returns a pointer past the
+ * digits, or nullptr if there aren't 4 hex digits.
+ */
+constexpr char const* read_hex4(
+    char const* pos,
+    char const* end,
+    char32_t& value) noexcept {
+    if (end - pos < 4) {
+        return nullptr;
+    }
+    value = 0;
+    for (int i = 0; i < 4; i++) {
+        int digit = hex_value(pos[i]);
+        if (digit < 0) {
+            return nullptr;
+        }
+        value = value * 16 + digit;
+    }
+    return pos + 4;
+}
+
+/**
+ * @brief Writes the UTF-8 encoding of a code point to out, and returns the
+ * number of bytes written (1 to 4)
+ */
+constexpr size_t encode_utf8(char32_t cp, char* out) noexcept {
+    if (cp < 0x80) {
+        out[0] = char(cp);
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = char(0xC0 | (cp >> 6));
+        out[1] = char(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = char(0xE0 | (cp >> 12));
+        out[1] = char(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = char(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = char(0xF0 | (cp >> 18));
+    out[1] = char(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = char(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = char(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+/**
+ * @brief Decodes a single escape sequence, writing the result to out and
+ * advancing it. `\uXXXX` escapes are written as UTF-8, and a UTF-16
+ * surrogate pair (such as `\ud83d\ude00`) is combined into a single code
+ * point.
+ *
+ * @param pos points to the character after the backslash
+ * @param end the end of the input
+ * @param out where to write the decoded character(s)
+ * @return char const* a pointer past the escape sequence, or nullptr if the
+ * escape sequence is invalid (including unpaired surrogates)
+ */
+constexpr char const* decode(
+    char const* pos,
+    char const* end,
+    char*& out) noexcept {
+    if (pos == end) {
+        return nullptr;
+    }
+    switch (*pos) {
+        case 'b': *out++ = '\b'; return pos + 1;
+        case 'f': *out++ = '\f'; return pos + 1;
+        case 'n': *out++ = '\n'; return pos + 1;
+        case 'r': *out++ = '\r'; return pos + 1;
+        case 't': *out++ = '\t'; return pos + 1;
+        case '\\': *out++ = '\\'; return pos + 1;
+        case '"': *out++ = '"'; return pos + 1;
+        case '/': *out++ = '/'; return pos + 1;
+        case 'u': {
+            char32_t cp = 0;
+            pos = read_hex4(pos + 1, end, cp);
+            if (!pos) {
+                return nullptr;
+            }
+            if (0xD800 <= cp && cp < 0xDC00) {
+                // A high surrogate must be followed by an escaped low one
+                char32_t low = 0;
+                if (end - pos < 2 || pos[0] != '\\' || pos[1] != 'u') {
+                    return nullptr;
+                }
+                pos = read_hex4(pos + 2, end, low);
+                if (!pos || low < 0xDC00 || 0xE000 <= low) {
+                    return nullptr;
+                }
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            } else if (0xDC00 <= cp && cp < 0xE000) {
+                return nullptr;
+            }
+            out += encode_utf8(cp, out);
+            return pos;
+        }
+        // Unrecognized escape codes are an error
+        default: return nullptr;
+    }
+}
+
+/**
+ * @brief Checks that every escape sequence in the contents of a string
+ * (without its quotes) is valid, without writing anything. Decoding in place
+ * does this first, so that an invalid string leaves its input as it was.
+ */
+inline bool validate_string(char const* pos, char const* end) {
+    for (;;) {
+        pos = simd::find(pos, end, '\\');
+        if (pos == end) {
+            return true;
+        }
+        // A single escape decodes to at most 4 bytes
+        char scratch[4];
+        char* out = scratch;
+        pos = decode(pos + 1, end, out);
+        if (!pos) {
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Decodes the contents of a string (without its quotes) into out,
+ * which must have room for end - pos bytes. Runs of characters between
+ * escapes are copied in bulk. out may be the same as pos, in which case the
+ * string is decoded in place.
+ *
+ * @return char* the end of the decoded output, or nullptr if the string
+ * contains an invalid escape sequence
+ */
+inline char* decode_string(char const* pos, char const* end, char* out) {
+    for (;;) {
+        char const* escape = simd::find(pos, end, '\\');
+        if (out != pos) {
+            std::memmove(out, pos, escape - pos);
+        }
+        out += escape - pos;
+        if (escape == end) {
+            return out;
+        }
+        pos = decode(escape + 1, end, out);
+        if (!pos) {
+            return nullptr;
+        }
+    }
+}
+} // namespace noam::unescape
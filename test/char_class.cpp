@@ -0,0 +1,104 @@
+#include "test_helpers.hpp"
+#include <noam/intrinsics.hpp>
+#include <noam/util/char_class.hpp>
+#include <random>
+#include <string>
+
+/**
+ * @brief Checks that the class's nibble tables, if exact, classify every
+ * byte the same way as the bitmap
+ */
+bool check_nibbles(noam::char_class cls) {
+    noam::nibble_table table = cls.nibbles();
+    if (!table.exact) {
+        return true;
+    }
+    for (int byte = 0; byte < 256; byte++) {
+        bool in_table = (table.lo[byte & 15] & table.hi[byte >> 4]) != 0;
+        if (in_table != cls.contains(char(byte))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks many_of<cls> against a scalar loop on random runs of bytes.
+ * Runs are long enough that they're classified in blocks.
+ */
+template <noam::char_class cls>
+bool check_runs(std::string_view members) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> length(0, 200);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<size_t> member(0, members.size() - 1);
+    for (int i = 0; i < 1000; i++) {
+        std::string input;
+        int run = length(gen);
+        for (int j = 0; j < run; j++) {
+            input += members[member(gen)];
+        }
+        input += char(byte(gen));
+        input += std::string(40, members[0]);
+
+        size_t expected = 0;
+        while (expected < input.size() && cls.contains(input[expected])) {
+            expected++;
+        }
+        auto result = noam::many_of<cls>.parse(input);
+        if (result.get_value().size() != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr noam::char_class sign = noam::char_class::of("+-");
+constexpr noam::char_class not_space = ~noam::char_classes::space;
+constexpr noam::char_class high_bytes = noam::char_class::range('\x80', '\xff');
+
+int main() {
+    TEST(noam::one_of<sign>, "-1", '-', "1");
+    TEST(noam::one_of<noam::char_classes::digit>, "7a", '7', "a");
+    all_passed = all_passed && !noam::one_of<sign>.parse("1")
+              && !noam::one_of<sign>.parse("");
+
+    constexpr noam::parser letters = noam::many_of<noam::char_classes::alpha>;
+    TEST(letters, "abcXYZ123", "abcXYZ", "123");
+    TEST(noam::many_of<noam::char_classes::digit>, "x", "", "x");
+    TEST(noam::many_of<not_space>, "token\tnext", "token", "\tnext");
+
+    TEST(noam::identifier, "snake_case_1 = 0", "snake_case_1", " = 0");
+    TEST(noam::identifier, "_", "_", "");
+    all_passed = all_passed && !noam::identifier.parse("9lives")
+              && !noam::identifier.parse("");
+    std::string long_name(100, 'a');
+    long_name += "_Z9(";
+    TEST(noam::identifier,
+         long_name,
+         std::string_view(long_name).substr(0, 103),
+         "(");
+
+    // Sets of more than 8 characters are checked with a table
+    constexpr noam::parser count_digits =
+        noam::count_ch<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'>;
+    std::string digits = "0123456789876543210123456789x";
+    TEST(count_digits, digits, 28, "x");
+
+    for (auto cls :
+         {noam::char_classes::identifier,
+          noam::char_classes::hex_digit,
+          noam::char_classes::space,
+          not_space,
+          high_bytes,
+          sign}) {
+        all_passed = all_passed && check_nibbles(cls);
+    }
+    all_passed = all_passed
+              && check_runs<noam::char_classes::identifier>(
+                     "abcxyzABCXYZ0189_")
+              && check_runs<noam::char_classes::hex_digit>("09afAF")
+              && check_runs<not_space>("ab\x80\xff~!")
+              && check_runs<high_bytes>("\x80\x9f\xc0\xff");
+    return all_passed ? 0 : 1;
+}
@@ -1,6 +1,14 @@
 #include "test_helpers.hpp"
 #include <noam/combinators.hpp>
 #include <noam/intrinsics.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <vector>
 
 constexpr noam::parser int_or_42 = noam::either(
     noam::parse_int,
@@ -16,9 +24,238 @@ static_assert(
         noam::pure_result<int>>,
     "Expected int_or_42 to have a result type of "
     "noam::pure_result<int>");
+// Counts the times a parser written as a lambda is tried
+int lambda_tries = 0;
+constexpr noam::parser counted_x = noam::parser {
+    [](noam::state_t st) -> noam::result<char> {
+        lambda_tries++;
+        return noam::one_of<noam::char_class::of("x")>.parse(st);
+    }};
+
+// Tries each kind of token in turn. The lambda parsing a negative number has
+// no FIRST set, so it's tried whenever the alternatives before it don't match.
+constexpr auto to = [](int i) { return [i](auto const&) { return i; }; };
+constexpr noam::parser token = noam::either<int>(
+    noam::literal_constant<1, "null">,
+    noam::literal_constant<2, "true", "false">,
+    noam::map([](int i) { return i * 10; }, noam::parse_uint),
+    noam::map(to(3), noam::sequence<'[', ']'>(noam::parse_int)),
+    noam::map(
+        to(4),
+        noam::with_first_set<noam::char_class::of("x")>(counted_x)),
+    noam::parser {[](noam::state_t st) { return noam::parse_int.parse(st); }},
+    noam::literal_constant<6, "nan">);
+static_assert(!noam::first_set_of<decltype(token)>());
+
+constexpr noam::parser keyword_or_number = noam::either(
+    noam::literal_constant<-1, "null">,
+    noam::parse_int);
+static_assert(
+    noam::first_set_of<decltype(keyword_or_number)>()
+    == (noam::char_classes::digit | noam::char_class::of("-n")));
+
+constexpr auto power = [](int base, int exp) {
+    int result = 1;
+    while (exp-- > 0) {
+        result *= base;
+    }
+    return result;
+};
+constexpr auto factorial = [](int n) {
+    int result = 1;
+    for (; n > 1; n--) {
+        result *= n;
+    }
+    return result;
+};
+constexpr auto arithmetic = noam::operator_table(
+    noam::infix_op<'+', 1>(std::plus<> {}),
+    noam::infix_op<'-', 1>(std::minus<> {}),
+    noam::infix_op<"**", 4, noam::assoc::right>(power),
+    noam::infix_op<'*', 2>(std::multiplies<> {}),
+    noam::prefix_op<'-', 3>(std::negate<> {}),
+    noam::postfix_op<'!', 5>(factorial));
+// Parenthesized expressions are operands
+constexpr noam::parser expression = noam::recurse<int>([](auto self) {
+    return noam::pratt(
+        noam::either(
+            noam::parse_int,
+            noam::enclose(noam::literal<'('>, self, noam::literal<')'>)),
+        arithmetic);
+});
+// An expression starts with an operand or a prefix operator
+constexpr noam::parser product = noam::pratt(
+    noam::literal_constant<1, 'x'>,
+    noam::operator_table(
+        noam::infix_op<'*', 1>(std::multiplies<> {}),
+        noam::prefix_op<'-', 2>(std::negate<> {})));
+static_assert(
+    noam::first_set_of<decltype(product)>() == noam::char_class::of("x-"));
+static_assert(product.parse("x*-x*x").check_value(-1));
+
+// Values which can't be default constructed are combined by recursing
+struct boxed {
+    int value;
+    explicit boxed(int value)
+      : value(value) {}
+    bool operator==(boxed const&) const = default;
+};
+constexpr noam::parser boxed_expression = noam::pratt(
+    noam::map([](int i) { return boxed(i); }, noam::parse_int),
+    noam::operator_table(
+        noam::infix_op<'+', 1>(
+            [](boxed a, boxed b) { return boxed(a.value + b.value); }),
+        noam::infix_op<'*', 2>(
+            [](boxed a, boxed b) { return boxed(a.value * b.value); })));
+
+// Fixed and bounded counts of elements, with and without separators
+constexpr noam::parser rgb = noam::repeat<3>(
+    noam::parse_uint8,
+    noam::comma_separator);
+constexpr noam::parser hex_word = noam::repeat<4>(
+    noam::one_of<noam::char_class::of("0123456789abcdef")>);
+static_assert(
+    noam::first_set_of<decltype(hex_word)>()
+    == noam::char_class::of("0123456789abcdef"));
+constexpr noam::parser boxed_pair = noam::repeat<2>(
+    noam::map([](int i) { return boxed(i); }, noam::parse_int),
+    noam::literal<'x'>);
+// Not default-constructible either, and not trivially copyable
+struct label {
+    std::string text;
+    explicit label(int value)
+      : text("#" + std::to_string(value)) {}
+    bool operator==(label const&) const = default;
+};
+constexpr noam::parser label_triple = noam::repeat<3>(
+    noam::map([](int i) { return label(i); }, noam::parse_int),
+    noam::comma_separator);
+constexpr noam::parser up_to_four = noam::repeat<1, 4>(
+    noam::parse_int,
+    noam::comma_separator);
+constexpr noam::parser up_to_two = noam::repeat<0, 2>(noam::parse_int);
+static_assert(!noam::first_set_of<decltype(up_to_two)>());
+
 int main() {
     TEST(int_or_42, "1234. hello", 1234, ". hello");
     TEST(int_or_42, "hello", 42, "hello");
     TEST(ws_int_ws, "    \t\t\r\n\t  32938\t\n\r\r\n   hewwo", 32938, "hewwo");
+
+    TEST(token, "null,", 1, ",");
+    TEST(token, "false,", 2, ",");
+    TEST(token, "12,", 120, ",");
+    TEST(token, "[1, 2],", 3, ",");
+    TEST(token, "x,", 4, ",");
+    TEST(token, "-5,", -5, ",");
+    TEST(token, "nan", 6, "");
+    all_passed = all_passed && !token.parse("") && !token.parse("-")
+              && !token.parse("nul");
+
+    // Only the alternatives which could match the first byte are tried
+    lambda_tries = 0;
+    for (auto input : {"null", "true", "12", "[]", "-1", "nan", "", "-"}) {
+        (void)token.parse(input);
+    }
+    all_passed = all_passed && lambda_tries == 0;
+    (void)token.parse("x");
+    all_passed = all_passed && lambda_tries == 1;
+
+    TEST(keyword_or_number, "null", -1, "");
+    TEST(keyword_or_number, "-12", -12, "");
+
+    // Sequences can be collected into any container, appended to one owned by
+    // the caller, or counted before they're allocated
+    using ints = std::vector<int>;
+    using pmr_ints = std::pmr::vector<int>;
+    std::pmr::monotonic_buffer_resource arena;
+    noam::parser pmr_list = noam::sequence_as<pmr_ints, '[', ',', ']'>(
+        noam::parse_int,
+        &arena);
+    auto in_arena = pmr_list.parse("[1, 2, 3] rest");
+    all_passed = all_passed && in_arena && in_arena.get_state() == " rest"
+              && std::ranges::equal(in_arena.get_value(), ints {1, 2, 3})
+              && in_arena.get_value().get_allocator().resource() == &arena;
+    all_passed = all_passed && !pmr_list.parse("[1, 2");
+    constexpr noam::parser deque_of_ints = noam::sequence_as<std::deque<int>>(
+        noam::parse_int);
+    auto in_deque = deque_of_ints.parse("4, 5,x");
+    all_passed = all_passed && in_deque.get_state() == ",x"
+              && std::ranges::equal(in_deque.get_value(), ints {4, 5});
+
+    ints row {0};
+    noam::parser append = noam::sequence_into(row, noam::parse_int);
+    noam::parser append_list = noam::sequence_into<'[', ',', ']'>(
+        row,
+        noam::parse_int);
+    TEST(append, "1, 2, 3;", size_t(3), ";");
+    TEST(append_list, "[4]", size_t(1), "");
+    all_passed = all_passed && !append_list.parse("[5, 6")
+              && row == ints {0, 1, 2, 3, 4};
+    TEST(append, "", size_t(0), "");
+
+    constexpr noam::parser exact_list = noam::sequence_exact<'[', ',', ']'>(
+        noam::parse_int);
+    auto exact = exact_list.parse("[1, 2, 3, 4, 5] rest");
+    all_passed = all_passed && exact.get_state() == " rest"
+              && exact.get_value() == ints {1, 2, 3, 4, 5}
+              && exact.get_value().capacity() == 5;
+    all_passed = all_passed && !exact_list.parse("[1, 2");
+    constexpr noam::parser exact_ints = noam::sequence_exact(noam::parse_int);
+    auto exact_unbracketed = exact_ints.parse("7, 8,");
+    all_passed = all_passed && exact_unbracketed.get_state() == ","
+              && exact_unbracketed.get_value() == ints {7, 8};
+
+    using bytes = std::array<uint8_t, 3>;
+    auto color = rgb.parse("255, 128, 0 rest");
+    all_passed = all_passed && color.get_state() == " rest"
+              && color.get_value() == bytes {255, 128, 0};
+    all_passed = all_passed && !rgb.parse("255, 128") && !rgb.parse("255, 128,")
+              && !rgb.parse("256, 0, 0");
+    auto word = hex_word.parse("beef!");
+    all_passed = all_passed && word.get_state() == "!"
+              && word.get_value() == std::array {'b', 'e', 'e', 'f'}
+              && !hex_word.parse("bee!");
+    auto dimensions = boxed_pair.parse("3x4");
+    all_passed = all_passed && dimensions
+              && dimensions.get_value() == std::array {boxed(3), boxed(4)}
+              && !boxed_pair.parse("3x");
+    auto labels = label_triple.parse("1, 22, 333 rest");
+    all_passed = all_passed && labels && labels.get_state() == " rest"
+              && labels.get_value()
+                     == std::array {label(1), label(22), label(333)}
+              && !label_triple.parse("1, 22");
+
+    auto four = up_to_four.parse("1, 2, 3, 4, 5");
+    all_passed = all_passed && four.get_state() == ", 5"
+              && std::ranges::equal(four.get_value(), ints {1, 2, 3, 4});
+    auto two = up_to_four.parse("1, 2, x");
+    all_passed = all_passed && two.get_state() == ", x"
+              && std::ranges::equal(two.get_value(), ints {1, 2});
+    all_passed = all_passed && !up_to_four.parse("") && !up_to_four.parse(",1");
+    auto none = up_to_two.parse("x");
+    all_passed = all_passed && none.get_state() == "x"
+              && none.get_value().empty();
+
+    TEST(expression, "1+2*3", 7, "");
+    TEST(expression, "10-2-3", 5, "");
+    TEST(expression, "2**3**2", 512, "");
+    TEST(expression, "-2**2", -4, "");
+    TEST(expression, "2*-3+1 rest", -5, " rest");
+    TEST(expression, "3!*2", 12, "");
+    TEST(expression, "-2!", -2, "");
+    TEST(expression, "(1+2)*(3-(4+5))", -18, "");
+    // An operator without a right operand is left in the input
+    TEST(expression, "1+2*", 3, "*");
+    TEST(expression, "1+(2", 1, "+(2");
+    all_passed = all_passed && !expression.parse("-") && !expression.parse("")
+              && !expression.parse("*2");
+    // Right-associative chains nest more deeply than the parser's stack
+    std::string chain = "1";
+    for (int i = 0; i < 40; i++) {
+        chain = "1**" + chain;
+    }
+    std::string chain_sum = chain + "+1**2";
+    TEST(expression, chain_sum, 2, "");
+    TEST(boxed_expression, "1+2*3+4 rest", boxed(11), " rest");
     return all_passed ? 0 : 1;
 }
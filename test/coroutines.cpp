@@ -0,0 +1,219 @@
+#include "test_helpers.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fmt/ranges.h>
+#include <noam/co_await.hpp>
+#include <noam/combinators.hpp>
+#include <noam/dictionary.hpp>
+#include <noam/intrinsics.hpp>
+#include <noam/push_parser.hpp>
+#include <vector>
+
+// A value that can't be default constructed, and which counts how many times
+// it's been copied
+struct tracked {
+    static inline int copies = 0;
+    int value;
+    explicit tracked(int value)
+      : value(value) {}
+    tracked(tracked const& other)
+      : value(other.value) {
+        copies++;
+    }
+    tracked(tracked&&) = default;
+    bool operator==(int other) const { return value == other; }
+};
+template <>
+struct fmt::formatter<tracked> : fmt::formatter<int> {
+    template <class Ctx>
+    auto format(tracked const& t, Ctx& ctx) {
+        return fmt::formatter<int>::format(t.value, ctx);
+    }
+};
+
+constexpr noam::parser parse_tracked = [](noam::state_t)
+    -> noam::result<tracked> {
+    int value = co_await noam::parse_int;
+    co_return tracked {value};
+} / noam::make_parser;
+
+constexpr noam::parser parse_ints = [](noam::state_t)
+    -> noam::result<std::vector<int>> {
+    std::vector<int> values;
+    values.push_back(co_await noam::parse_int);
+    noam::parser next = noam::try_parse(noam::comma_separator >> noam::parse_int);
+    while (std::optional value = co_await next) {
+        values.push_back(*value);
+    }
+    co_return std::move(values);
+} / noam::make_parser;
+
+noam::push_parser<long> push_sum() {
+    long sum = co_await noam::parse_long;
+    noam::parser next = noam::try_parse(noam::comma_separator >> noam::parse_long);
+    while (std::optional value = co_await next) {
+        sum += *value;
+    }
+    co_return sum;
+}
+
+// Counts how many times the push parser runs it, to check that a long token
+// arriving in small fragments isn't parsed again for every fragment
+static int whitespace_runs = 0;
+constexpr noam::parser counted_whitespace = [](noam::state_t st) {
+    whitespace_runs++;
+    return noam::whitespace.parse(st);
+} / noam::make_parser;
+
+noam::push_parser<long> push_spaces() {
+    co_await counted_whitespace;
+    co_return co_await noam::parse_long;
+}
+
+noam::push_parser<double> push_double() {
+    co_return co_await noam::parse_double;
+}
+
+noam::push_parser<long> push_long() {
+    co_return co_await noam::parse_long;
+}
+
+noam::push_parser<bool> push_literal() {
+    co_await noam::literal<"abcd", "ab">;
+    co_return true;
+}
+
+noam::push_parser<size_t> push_word(noam::dictionary const& words) {
+    co_return co_await noam::parse_dictionary(words);
+}
+
+noam::push_parser<long> push_lists() {
+    long sum = 0;
+    noam::parser next = noam::try_parse(
+        noam::whitespace >> noam::sequence<'[', ',', ']'>(noam::parse_int));
+    while (std::optional values = co_await next) {
+        for (int value : *values) {
+            sum += value;
+        }
+    }
+    co_return sum;
+}
+
+// Splits the input in two at every byte, and checks that the push parser
+// gives the same result as if the input had arrived all at once
+template <class Make, class T>
+void test_split(
+    Make make,
+    std::string_view input,
+    T expected,
+    std::string_view remainder) {
+    bool passed = true;
+    for (size_t i = 0; i <= input.size(); i++) {
+        auto parser = make();
+        parser.feed(input.substr(0, i));
+        parser.feed(input.substr(i));
+        passed = passed && parser.finish() == noam::push_status::done
+              && parser.get_value() == expected
+              && parser.remaining() == noam::state_t(remainder);
+    }
+    all_passed = all_passed && passed;
+    fmt::print(
+        "\n- name:      \"split\"\n  input:     {}\n  passed:    {}\n",
+        input,
+        passed);
+}
+
+void test_push(
+    std::vector<std::string_view> fragments,
+    noam::push_status expected_status,
+    long expected,
+    noam::state_t remainder) {
+    auto parser = push_sum();
+    for (auto fragment : fragments) {
+        parser.feed(fragment);
+    }
+    auto status = parser.finish();
+    bool passed = status == expected_status
+               && (status != noam::push_status::done
+                   || (parser.get_value() == expected
+                       && parser.remaining() == remainder));
+    all_passed = all_passed && passed;
+    fmt::print(
+        "\n- name:      \"push_sum\"\n  input:     {}\n  passed:    {}\n",
+        fragments,
+        passed);
+}
+
+int main() {
+    // The value should be moved out of the promise, never copied
+    {
+        auto result = parse_tracked.parse("1234");
+        all_passed = all_passed && result && result.get_value() == 1234;
+        fmt::print("copies of tracked: {}\n", tracked::copies);
+        all_passed = all_passed && tracked::copies == 0;
+    }
+    TEST(parse_tracked, "1234. hello", 1234, ". hello");
+    TEST(parse_ints, "1, 2, 3. hello", (std::vector {1, 2, 3}), ". hello");
+    TEST(parse_ints, "1, 2, 3", (std::vector {1, 2, 3}), "");
+
+    auto failed = parse_tracked.parse("hello");
+    all_passed = all_passed && !failed;
+
+    test_push({"12, 3", "4, 5"}, noam::push_status::done, 51, "");
+    test_push({"1", ",", " ", "2", "0", ".", "x"}, noam::push_status::done, 21, ".x");
+    test_push({"1, 2, ", "3"}, noam::push_status::done, 6, "");
+    test_push({"hello"}, noam::push_status::failed, 0, "");
+
+    // A fragment boundary far past the last complete value. The separator
+    // reached the end of the input, so the parse waits for more.
+    std::string spaces(300, ' ');
+    std::string after_comma = "1," + spaces;
+    test_push({after_comma, "2"}, noam::push_status::done, 3, "");
+    std::string before_comma = "1" + spaces;
+    test_push({before_comma, ", 2", "0"}, noam::push_status::done, 21, "");
+    std::string rest = spaces + "x";
+    test_push({before_comma, "x"}, noam::push_status::done, 1, rest);
+
+    auto long_token = push_spaces();
+    for (int i = 0; i < 4096; i++) {
+        long_token.feed(" ");
+    }
+    long_token.feed("42");
+    all_passed = all_passed
+              && long_token.finish() == noam::push_status::done
+              && long_token.get_value() == 42 && whitespace_runs <= 16;
+
+    // Tokens cut off by a fragment boundary
+    test_split(push_double, "1e5,", 1e5, ",");
+    test_split(push_double, "-12.5e-3;", -12.5e-3, ";");
+    test_split(push_double, "-infinity ", -HUGE_VAL, " ");
+    test_split(push_long, "123456,", 123456L, ",");
+    test_split(push_long, "-7 ", -7L, " ");
+    test_split(push_literal, "abcd;", true, ";");
+    test_split(push_literal, "abc;", true, "c;");
+    noam::dictionary words {"ab", "abcd", "abcdef"};
+    auto make_word = [&] { return push_word(words); };
+    test_split(make_word, "abcdefg", size_t(2), "g");
+    test_split(make_word, "abcde", size_t(1), "e");
+
+    // Complete records are consumed as they arrive, rather than being kept
+    // until the input is finished
+    {
+        auto lists = push_lists();
+        size_t most_buffered = 0;
+        for (int i = 0; i < 1000; i++) {
+            lists.feed("[1,2,3] ");
+            size_t buffered = lists.remaining().size();
+            most_buffered = std::max(most_buffered, buffered);
+        }
+        bool passed = lists.finish() == noam::push_status::done
+                   && lists.get_value() == 6000 && most_buffered < 32;
+        all_passed = all_passed && passed;
+        fmt::print(
+            "\n- name:      \"push_lists\"\n  buffered:  {}\n"
+            "  passed:    {}\n",
+            most_buffered,
+            passed);
+    }
+    return all_passed ? 0 : 1;
+}
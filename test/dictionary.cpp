@@ -0,0 +1,82 @@
+#include "test_helpers.hpp"
+#include <noam/dictionary.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Finds the longest word prefixing the input by checking every word,
+ * to compare against the dictionary
+ */
+size_t longest_match(
+    std::vector<std::string> const& words,
+    std::string_view input,
+    size_t& length) {
+    size_t best = noam::dictionary::npos;
+    length = 0;
+    for (size_t id = 0; id < words.size(); id++) {
+        bool longer = best == noam::dictionary::npos
+                   || words[id].size() > length;
+        if (longer && input.starts_with(words[id])) {
+            best = id;
+            length = words[id].size();
+        }
+    }
+    return best;
+}
+
+int main() {
+    noam::dictionary fields {"id", "name", "named", "name_id", "", "nam"};
+    auto field = noam::parse_dictionary(fields);
+    TEST(field, "named: x", 2, ": x");
+    TEST(field, "name: x", 1, ": x");
+    TEST(field, "name_i", 1, "_i");
+    TEST(field, "na", 4, "na");
+    TEST(field, "", 4, "");
+    all_passed = all_passed && fields.id_of("nam") == 5
+              && fields.id_of("na") == noam::dictionary::npos
+              && fields.size() == 6;
+
+    // Duplicate words keep their first id. Bytes above 127 are ordinary
+    // characters.
+    noam::dictionary codes {"A1", "\xff\xfe", "A1", "A12"};
+    auto code = noam::parse_dictionary(codes);
+    TEST(code, "A1 ", 0, " ");
+    TEST(code, "A123", 3, "3");
+    TEST(code, "\xff\xfe\xff", 1, "\xff");
+    all_passed = all_passed && !code.parse("B") && !code.parse("\xff")
+              && !code.parse("");
+
+    // Compare against checking every word, over random words drawn from a
+    // small alphabet so that they share many prefixes
+    std::mt19937 gen(42);
+    auto random_word = [&](size_t max_length) {
+        std::string word(gen() % (max_length + 1), ' ');
+        for (char& ch : word) {
+            ch = "abc\x80"[gen() % 4];
+        }
+        return word;
+    };
+    std::vector<std::string> words;
+    for (int i = 0; i < 2000; i++) {
+        words.push_back(random_word(8));
+    }
+    noam::dictionary random_words(words);
+    bool passed = true;
+    for (int i = 0; i < 20000; i++) {
+        std::string input = random_word(12);
+        size_t expected_length = 0;
+        size_t expected = longest_match(words, input, expected_length);
+        size_t length = 0;
+        size_t id = random_words.find(input, length);
+        passed = passed && id == expected && length == expected_length;
+    }
+    all_passed = all_passed && passed;
+    fmt::print(
+        R"(
+- name:      "dictionary::find matches a linear search"
+  passed:    {}
+)",
+        passed);
+    return all_passed ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+#include "test_helpers.hpp"
+#include <map>
+#include <noam/combinators.hpp>
+#include <noam/flat_map.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using flat_ints = noam::flat_map<std::string_view, int>;
+using tree_ints = std::map<std::string_view, int>;
+using hash_ints = std::unordered_map<std::string_view, int>;
+
+template <class Map, noam::duplicate_keys Duplicates>
+constexpr noam::parser parse_ints = noam::parse_map_bulk<Map, Duplicates>(
+    noam::parse_string_view,
+    noam::parse_int);
+
+/**
+ * @brief Checks that each kind of map parses `input` into `expected` (or
+ * fails to, if `expected` is empty)
+ */
+template <noam::duplicate_keys Duplicates>
+bool check_maps(std::string_view input, tree_ints const& expected) {
+    auto flat = parse_ints<flat_ints, Duplicates>.parse(input);
+    auto tree = parse_ints<tree_ints, Duplicates>.parse(input);
+    auto hash = parse_ints<hash_ints, Duplicates>.parse(input);
+    if (expected.empty()) {
+        return !flat && !tree && !hash;
+    }
+    return flat && tree && hash
+        && tree_ints(flat.get_value().begin(), flat.get_value().end())
+               == expected
+        && tree.get_value() == expected
+        && tree_ints(hash.get_value().begin(), hash.get_value().end())
+               == expected;
+}
+
+int main() {
+    using enum noam::duplicate_keys;
+    std::string_view input = R"({"b": 2, "a": 1, "c": 3, "a": 4} rest)";
+    auto flat = parse_ints<flat_ints, keep_first>.parse(input);
+    all_passed = all_passed && flat.get_state() == " rest"
+              && flat.get_value().size() == 3 && flat.get_value().at("a") == 1
+              && flat.get_value().begin()->first == "a"
+              && !flat.get_value().contains("d");
+
+    all_passed = all_passed
+              && check_maps<keep_first>(input, {{"a", 1}, {"b", 2}, {"c", 3}})
+              && check_maps<keep_last>(input, {{"a", 4}, {"b", 2}, {"c", 3}})
+              && check_maps<fail>(input, {})
+              && check_maps<fail>(R"({"b": 2, "a": 1})", {{"a", 1}, {"b", 2}})
+              && check_maps<keep_first>(R"({"a": 1)", {});
+    auto empty = parse_ints<hash_ints, fail>.parse("{ }");
+    all_passed = all_passed && empty && empty.get_value().empty();
+
+    // Maps nested in other maps share a buffer for their pairs, which must be
+    // left as it was after each map, whether or not it was parsed
+    using nested_map = std::map<std::string_view, tree_ints>;
+    constexpr noam::parser nested = noam::parse_map_bulk<nested_map>(
+        noam::parse_string_view,
+        parse_ints<tree_ints, keep_first>);
+    auto outer = nested.parse(R"({"y": {"b": 2}, "x": {"a": 1, "c": 3}})");
+    nested_map expected_outer {
+        {"x", {{"a", 1}, {"c", 3}}},
+        {"y", {{"b", 2}}}};
+    all_passed = all_passed && outer && outer.get_value() == expected_outer;
+    using pair_t = std::pair<std::string_view, int>;
+    all_passed = all_passed && !nested.parse(R"({"x": {"a": 1}, "y": {"b")")
+              && noam::pending_pairs<pair_t>().empty();
+
+    // Keys are converted to the map's key type, even if the key parser gives
+    // a different type
+    using owning_map = std::map<std::string, int>;
+    constexpr noam::parser owning = noam::parse_map_bulk<owning_map>(
+        noam::parse_string_view,
+        noam::parse_int);
+    auto owned = owning.parse(R"({"b": 2, "a": 1})");
+    all_passed = all_passed && owned
+              && owned.get_value() == owning_map {{"a", 1}, {"b", 2}};
+
+    // If a value parser throws, the pairs parsed so far are still removed
+    constexpr noam::parser throwing = noam::parse_map_bulk<owning_map>(
+        noam::parse_string_view,
+        [](noam::state_t st) -> noam::result<int> {
+            auto r = noam::parse_int.parse(st);
+            if (r && r.get_value() < 0) {
+                throw std::runtime_error("negative value");
+            }
+            return r;
+        } / noam::make_parser);
+    bool threw = false;
+    try {
+        throwing.parse(R"({"a": 1, "b": -1})");
+    } catch (std::runtime_error const&) {
+        threw = true;
+    }
+    using owning_pair = std::pair<std::string, int>;
+    all_passed = all_passed && threw
+              && noam::pending_pairs<owning_pair>().empty();
+
+    // Random keys, many of them repeated, against inserting them one at a time
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> key(0, 300);
+    std::vector<std::string> keys;
+    std::string object = "{";
+    tree_ints first_values, last_values;
+    for (int i = 0; i < 1000; i++) {
+        keys.push_back("k" + std::to_string(key(gen)));
+    }
+    for (int i = 0; i < 1000; i++) {
+        object += (i ? ", \"" : "\"") + keys[i] + "\": " + std::to_string(i);
+        first_values.emplace(keys[i], i);
+        last_values.insert_or_assign(keys[i], i);
+    }
+    object += "}";
+    all_passed = all_passed && check_maps<keep_first>(object, first_values)
+              && check_maps<keep_last>(object, last_values)
+              && check_maps<fail>(object, {});
+
+    // Flat maps can also be built one key at a time
+    flat_ints inserted;
+    for (auto& [k, v] : last_values) {
+        inserted[k] = v;
+    }
+    all_passed = all_passed
+              && inserted == parse_ints<flat_ints, keep_last>.parse(object)
+                                 .get_value();
+    return all_passed ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#include "test_helpers.hpp"
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <noam/co_await.hpp>
+#include <noam/intrinsics.hpp>
+#include <noam/util/frame_pool.hpp>
+
+// Count every call to the global allocator, to check that parsing allocates
+// nothing once the pool holds a frame
+static size_t allocation_count = 0;
+
+// GCC sees operator new's memory being released with std::free, which is
+// what these replacements are meant to do
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t size) {
+    allocation_count++;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * @brief Forwards to the default resource, counting the blocks allocated and
+ * freed through it
+ */
+struct counting_resource : std::pmr::memory_resource {
+    size_t allocated = 0;
+    size_t deallocated = 0;
+
+    void* do_allocate(size_t bytes, size_t align) override {
+        allocated++;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* ptr, size_t bytes, size_t align) override {
+        deallocated++;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, align);
+    }
+    bool do_is_equal(std::pmr::memory_resource const& other)
+        const noexcept override {
+        return this == &other;
+    }
+};
+
+constexpr noam::parser parse_pair = [](noam::state_t) -> noam::result<int> {
+    int x = co_await noam::parse_int;
+    co_await noam::comma_separator;
+    int y = co_await noam::parse_int;
+    co_return x + y;
+} / noam::make_parser;
+
+int main() {
+    // A freed frame is reused by the next frame in the same bucket
+    void* frame = noam::frame_pool::allocate(100);
+    noam::frame_pool::deallocate(frame, 100);
+    void* same_bucket = noam::frame_pool::allocate(90);
+    all_passed = all_passed && same_bucket == frame;
+    noam::frame_pool::deallocate(same_bucket, 90);
+
+    // Once the first parse has freed its frame, parsing doesn't allocate
+    TEST(parse_pair, "1, 2", 3, "");
+    size_t before = allocation_count;
+    for (int i = 0; i < 1000; i++) {
+        all_passed = all_passed && parse_pair.parse("20, 22").check_value(42);
+    }
+    all_passed = all_passed && allocation_count == before;
+
+    // Frames go back to the resource they came from, even if another
+    // resource is installed by the time they're freed
+    counting_resource first, second;
+    void* from_first = nullptr;
+    void* from_pool = noam::frame_pool::allocate(100);
+    {
+        noam::scoped_frame_resource scope {&first};
+        from_first = noam::frame_pool::allocate(100);
+        TEST(parse_pair, "3, 4", 7, "");
+        all_passed = all_passed && first.allocated == 2
+                  && first.deallocated == 1;
+        noam::scoped_frame_resource nested {&second};
+        noam::frame_pool::deallocate(from_first, 100);
+        noam::frame_pool::deallocate(from_pool, 100);
+    }
+    all_passed = all_passed && first.deallocated == 2
+              && second.allocated == 0 && second.deallocated == 0;
+
+    // The pool is installed again once the scopes end
+    before = allocation_count;
+    all_passed = all_passed && parse_pair.parse("5, 6").check_value(11)
+              && allocation_count == before
+              && first.allocated == 2;
+    return all_passed ? 0 : 1;
+}
@@ -1,8 +1,10 @@
 #include "test_helpers.hpp"
 #include <cmath>
+#include <limits>
 #include <noam/intrinsics.hpp>
 #include <noam/util/fmt.hpp>
 #include <optional>
+#include <string>
 
 int main() {
     TEST(noam::parse_short, "1234. hello", 1234, ". hello");
@@ -21,11 +23,201 @@ int main() {
     TEST(noam::parse_int64, "1234. hello", 1234, ". hello");
     TEST(noam::parse_uint64, "1234. hello", 1234, ". hello");
 
+    // Integers are converted 8 digits at a time, so check values on either
+    // side of a word boundary, and at the limits of each type
+    TEST(noam::parse_int16, "-32768 rest", -32768, " rest");
+    TEST(noam::parse_uint32, "4294967295,", 4294967295u, ",");
+    TEST(noam::parse_int64,
+         "-9223372036854775808",
+         std::numeric_limits<int64_t>::min(),
+         "");
+    TEST(noam::parse_uint64,
+         "00000000000000000000018446744073709551615 rest",
+         std::numeric_limits<uint64_t>::max(),
+         " rest");
+    TEST(noam::parse_ulong, "123456789012x", 123456789012ul, "x");
+    TEST(noam::parse_charconv_unchecked<int>,
+         "-12345678 rest",
+         -12345678,
+         " rest");
+    for (auto overflow : {"32768", "-32769", "100000"}) {
+        all_passed = all_passed && !noam::parse_int16.parse(overflow);
+    }
+    for (auto invalid : {"-1", "18446744073709551616", "", "x1"}) {
+        all_passed = all_passed && !noam::parse_uint64.parse(invalid);
+    }
+
     TEST(noam::parse_float, "3.14159hello", 3.14159, "hello");
     TEST(noam::parse_float, "3.14159e10hello", 3.14159e10, "hello");
     TEST(noam::parse_double, "3.14159hello", 3.14159, "hello");
     TEST(noam::parse_double, "3.14159e10hello", 3.14159e10, "hello");
     TEST(noam::parse_long_double, "3.14159hello", 3.14159, "hello");
     TEST(noam::parse_long_double, "3.14159e10hello", 3.14159e10, "hello");
+
+    // long double keeps its precision, whichever way it's parsed
+    long double third = 0.333333333333333333333L;
+    TEST(noam::parse_long_double, "0.333333333333333333333", third, "");
+    long double parsed_third = 0;
+    std::string_view third_text = "0.333333333333333333333,";
+    char const* third_end = noam::floating::parse_with_strtold(
+        third_text.data(),
+        third_text.data() + third_text.size(),
+        parsed_third);
+    all_passed = all_passed && third_end == &third_text.back()
+              && parsed_third == third;
+
+    // The general grammar accepts what std::from_chars does, while JSON
+    // numbers stop at anything JSON doesn't allow
+    TEST(noam::parse_double, "1.e5", 1e5, "");
+    TEST(noam::parse_double, ".5,", 0.5, ",");
+    auto infinity = noam::parse_double.parse("-Infinity");
+    all_passed = all_passed && infinity && std::isinf(infinity.get_value())
+              && infinity.get_value() < 0;
+    TEST(noam::parse_json_double, "-0.5e+3,", -500.0, ",");
+    TEST(noam::parse_json_double, "1.e5", 1.0, ".e5");
+    TEST(noam::parse_json_double, "012", 0.0, "12");
+    TEST(noam::parse_json_double, "2E-2x", 0.02, "x");
+    TEST(noam::parse_json_double, "3e+", 3.0, "e+");
+    TEST(noam::parse_json_float, "1.5]", 1.5f, "]");
+    for (auto invalid : {".5", "-", "+1", "Infinity", "NaN", "1e999"}) {
+        all_passed = all_passed && !noam::parse_json_double.parse(invalid);
+    }
+    all_passed = all_passed && !noam::parse_double.parse("1e999");
+
+    // Numbers which round to infinity or zero are out of range, whichever
+    // library parses them, but zero and infinity themselves aren't
+    for (auto invalid : {"1e999", "-1e999", "1e-400", "-0.5e-400", "1e40"}) {
+        all_passed = all_passed && !noam::parse_float.parse(invalid)
+                  && !noam::parse_json_float.parse(invalid);
+    }
+    for (auto invalid : {"1e-400", "0.001e-999", "2e-324", "-1e400"}) {
+        all_passed = all_passed && !noam::parse_double.parse(invalid)
+                  && !noam::parse_json_double.parse(invalid);
+    }
+    TEST(noam::parse_double, "0e999,", 0.0, ",");
+    TEST(noam::parse_double, "-0.000e-999", 0.0, "");
+    TEST(noam::parse_json_double, "0.0e-400", 0.0, "");
+    TEST(noam::parse_double, "1e-310", 1e-310, "");
+    auto float_infinity = noam::parse_float.parse("inf");
+    all_passed = all_passed && float_infinity
+              && std::isinf(float_infinity.get_value());
+
+    // Short literals are compared a word at a time, except near the end of
+    // the input, where a whole word can't be read
+    TEST(noam::parse_bool, "true", true, "");
+    TEST(noam::parse_bool, "false]", false, "]");
+    TEST(noam::parse_bool, "true, false, null", true, ", false, null");
+    for (auto invalid : {"tru", "fals", "truE", "True", "falsy, true", ""}) {
+        all_passed = all_passed && !noam::parse_bool.parse(invalid);
+    }
+    constexpr noam::parser http_version = noam::literal<"HTTP/1.1">;
+    TEST(http_version, "HTTP/1.1", noam::empty {}, "");
+    TEST(http_version, "HTTP/1.1 200 OK", noam::empty {}, " 200 OK");
+    for (auto invalid : {"HTTP/1.0 200 OK", "HTTP/1.", "http/1.1 200 OK"}) {
+        all_passed = all_passed && !http_version.parse(invalid);
+    }
+    TEST(noam::literal<"ab">, "abcdef", noam::empty {}, "cdef");
+    all_passed = all_passed && !noam::literal<"ab">.parse("ac")
+              && !noam::literal<"ab">.parse("a");
+
+    // Larger sets of literals are matched with a trie, which must still pick
+    // the first literal that matches
+    constexpr noam::parser http_method = noam::literal_constant<
+        true,
+        "GET",
+        "HEAD",
+        "POST",
+        "PUT",
+        "DELETE",
+        "CONNECT",
+        "OPTIONS",
+        "TRACE",
+        "PATCH",
+        "P">;
+    TEST(http_method, "PATCH /", true, " /");
+    TEST(http_method, "PUTS", true, "S");
+    TEST(http_method, "PROPFIND", true, "ROPFIND");
+    all_passed = all_passed && !http_method.parse("GE")
+              && !http_method.parse("get") && !http_method.parse("");
+
+    // Long enough to be scanned in blocks, with a tail that isn't
+    std::string spaces(100, ' ');
+    std::string indented = spaces + "x";
+    std::string mixed = spaces + "\t\r\n" + spaces + "x";
+    TEST(noam::count_spaces, indented, 100, "x");
+    TEST(noam::count_spaces, spaces, 100, "");
+    TEST(noam::whitespace, mixed, noam::empty {}, "x");
+
+    // Escapes escape the next character, so even runs of backslashes don't
+    // escape the closing quote. The long strings are scanned in blocks.
+    std::string text(70, 'a');
+    std::string escaped_quote = "\"" + text + "\\\"" + text + "\" rest";
+    std::string escaped_escape = "\"" + text + "\\\\\" rest";
+    std::string unterminated = "\"" + text + "\\\"";
+    TEST(noam::parse_string_view,
+         escaped_quote,
+         std::string_view(escaped_quote).substr(1, 142),
+         " rest");
+    TEST(noam::parse_string_view,
+         escaped_escape,
+         std::string_view(escaped_escape).substr(1, 72),
+         " rest");
+    TEST(noam::parse_string_view, R"("\\\"" rest)", R"(\\\")", " rest");
+    all_passed = all_passed && !noam::parse_string_view.parse(unterminated);
+
+    using std::string_literals::operator""s;
+    TEST(noam::parse_string, R"("hello" world)", "hello"s, " world");
+    TEST(noam::parse_string,
+         R"("a\tb\nc\\d\"e\/f")",
+         "a\tb\nc\\d\"e/f"s,
+         "");
+    TEST(noam::parse_string, R"("caf\u00e9")", "caf\u00e9"s, "");
+    TEST(noam::parse_string, R"("\u20AC!")", "\u20ac!"s, "");
+    TEST(noam::parse_string, R"("\ud83d\ude00")", "\U0001F600"s, "");
+    TEST(noam::parse_string, escaped_escape, text + "\\", " rest");
+    for (auto invalid :
+         {R"("\x")", R"("\u12")", R"("\ud83d")", R"("\ude00")", R"("abc)"}) {
+        all_passed = all_passed && !noam::parse_string.parse(invalid);
+    }
+
+    // Strings without escapes are borrowed from the input
+    std::string plain = R"("hello" world)";
+    auto borrowed = noam::parse_string_cow.parse(plain);
+    TEST(noam::parse_string_cow, plain, "hello", " world");
+    all_passed = all_passed && !borrowed.get_value().owns_text()
+              && borrowed.get_value().data() == plain.data() + 1;
+    std::string escaped = R"("caf\u00e9\n" world)";
+    auto owned = noam::parse_string_cow.parse(escaped);
+    TEST(noam::parse_string_cow, escaped, "caf\u00e9\n", " world");
+    all_passed = all_passed && owned.get_value().owns_text();
+
+    // Decoding in place overwrites the string, but not the rest of the input
+    std::string buffer = R"("a\tb\ud83d\ude00c" "next")";
+    noam::parser insitu = noam::parse_string_insitu(buffer);
+    auto decoded = insitu.parse(buffer);
+    auto next = insitu.parse(noam::state_t(decoded.get_state()).substr(1));
+    all_passed = all_passed && decoded.check_value("a\tb\U0001F600c")
+              && decoded.get_value().data() == buffer.data() + 1
+              && next.check_value("next");
+    std::string elsewhere = R"("not in the buffer")";
+    all_passed = all_passed && !insitu.parse(elsewhere);
+
+    // A string with an invalid escape is rejected before any of it is decoded
+    std::string invalid = R"("ab\ncd\q" rest)";
+    std::string const original = invalid;
+    all_passed = all_passed
+              && !noam::parse_string_insitu(invalid).parse(invalid)
+              && invalid == original;
+
+    // Strings without escapes aren't written to, so they can be parsed again,
+    // but a string with escapes reads differently once it's been decoded
+    std::string unescaped = R"("x y" z)";
+    noam::parser reparse = noam::parse_string_insitu(unescaped);
+    all_passed = all_passed && reparse.parse(unescaped).check_value("x y")
+              && reparse.parse(unescaped).check_value("x y");
+    std::string quoted = R"("x\"y" z)";
+    noam::parser once = noam::parse_string_insitu(quoted);
+    all_passed = all_passed && once.parse(quoted).check_value("x\"y")
+              && once.parse(quoted).check_value("x");
     return all_passed ? 0 : 1;
 }
@@ -0,0 +1,53 @@
+#include "test_helpers.hpp"
+#include <noam/line_index.hpp>
+#include <string>
+
+void test_locate(
+    noam::line_index& index,
+    size_t offset,
+    size_t expected_line,
+    size_t expected_column) {
+    auto [line, column] = index.locate(index.get_document().data() + offset);
+    bool passed = line == expected_line && column == expected_column;
+    all_passed = all_passed && passed;
+    fmt::print(
+        R"(
+- name:      "line_index::locate"
+  offset:    {}
+  expected:  {}:{}
+  obtained:  {}:{}
+  passed:    {}
+)",
+        offset,
+        expected_line,
+        expected_column,
+        line,
+        column,
+        passed);
+}
+
+int main() {
+    std::string input = "ab\ncd\n\nefg";
+    noam::line_index index(input);
+    test_locate(index, 0, 1, 1);
+    test_locate(index, 2, 1, 3);
+    test_locate(index, 3, 2, 1);
+    test_locate(index, 6, 3, 1);
+    test_locate(index, 7, 4, 1);
+    test_locate(index, input.size(), 4, 4);
+
+    // Long enough that newlines are found by the vectorized scan
+    std::string lines;
+    for (int i = 0; i < 100; i++) {
+        lines += std::string(i % 37, 'x') + "\n";
+    }
+    noam::line_index long_index(lines);
+    size_t offset = 0;
+    for (int i = 0; i < 100; i++) {
+        test_locate(long_index, offset + i % 37, i + 1, i % 37 + 1);
+        offset += i % 37 + 1;
+    }
+    all_passed = all_passed && long_index.line_count() == 101
+              && long_index.line(3) == "xx" && long_index.line(101) == "";
+    return all_passed ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+#include "test_helpers.hpp"
+#include <filesystem>
+#include <fstream>
+#include <noam/combinators.hpp>
+#include <noam/intrinsics.hpp>
+#include <noam/mapped_file.hpp>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Writes `contents` to a file in the temporary directory, returning its
+ * path
+ */
+fs::path write_file(std::string const& name, std::string const& contents) {
+    fs::path path = fs::temp_directory_path() / name;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << contents;
+    return path;
+}
+
+int main() {
+    // An empty file gives an empty state, which is still a valid input
+    fs::path empty_path = write_file("noam_test_empty.txt", "");
+    noam::mapped_file empty(empty_path);
+    all_passed = all_passed && empty.empty() && empty.size() == 0
+              && empty.data() != nullptr;
+    TEST(noam::whitespace, empty.state(), noam::empty {}, "");
+
+    std::string contents = "1234, 5678\n";
+    fs::path small_path = write_file("noam_test_small.txt", contents);
+    noam::mapped_file small(small_path);
+    all_passed = all_passed && small.size() == contents.size()
+              && small.state() == contents;
+    TEST(noam::parse_int, small, 1234, ", 5678\n");
+
+    // Moving the file keeps the views into it valid
+    noam::state_t view = small.state();
+    noam::mapped_file moved = std::move(small);
+    all_passed = all_passed && moved.data() == view.data() && small.empty()
+              && moved.state() == contents;
+
+    // Missing files throw
+    bool threw = false;
+    try {
+        noam::mapped_file missing(fs::temp_directory_path() / "noam_missing");
+    } catch (std::system_error const& e) {
+        threw = e.code() == std::errc::no_such_file_or_directory;
+    }
+    all_passed = all_passed && threw;
+
+#if NOAM_HAS_MMAP
+    // Files which don't report their size, such as devices and files in
+    // /proc, are read rather than mapped
+    if (fs::exists("/proc/self/status")) {
+        noam::mapped_file status("/proc/self/status");
+        all_passed = all_passed && status.state().starts_with("Name:");
+    }
+    if (fs::exists("/dev/null")) {
+        all_passed = all_passed && noam::mapped_file("/dev/null").empty();
+    }
+#endif
+
+    constexpr noam::parser numbers = noam::sequence(noam::parse_int);
+    auto [file, result] = noam::parse_file(small_path, numbers);
+    all_passed = all_passed && file.state() == contents
+              && result.get_value() == std::vector {1234, 5678}
+              && result.get_state() == "\n";
+
+    fs::remove(empty_path);
+    fs::remove(small_path);
+    return all_passed ? 0 : 1;
+}
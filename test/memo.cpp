@@ -0,0 +1,91 @@
+#include "test_helpers.hpp"
+#include <noam/combinators.hpp>
+#include <noam/memo.hpp>
+#include <string>
+
+int digit_tries = 0;
+constexpr noam::parser counted_digit = noam::parser {
+    [](noam::state_t st) -> noam::result<char> {
+        digit_tries++;
+        return noam::one_of<noam::char_classes::digit>.parse(st);
+    }};
+
+// Both alternatives start by parsing a digit, so without memoization the
+// digit is parsed twice whenever the first alternative fails
+constexpr noam::parser digit = noam::memo(counted_digit);
+constexpr noam::parser digit_then_suffix = noam::either(
+    noam::join(digit, noam::literal_constant<'!', '!'>),
+    noam::join(digit, noam::literal_constant<'?', '?'>));
+
+constexpr noam::parser open = noam::literal<'('>;
+constexpr auto plus_one = [](int depth) { return depth + 1; };
+
+/**
+ * @brief Parses "a", "(a)", "((a))!", and so on, returning the depth. Both
+ * alternatives parse the nested value before they can fail, so without
+ * memoization, the number of parses doubles with each level.
+ */
+constexpr noam::parser nested = noam::recurse<int>([](auto self) {
+    return noam::memo(noam::either(
+        noam::map(plus_one, noam::enclose(open, self, noam::literal<")!">)),
+        noam::map(plus_one, noam::enclose(open, self, noam::literal<')'>)),
+        noam::literal_constant<0, 'a'>));
+});
+
+// A left-recursive rule: list = list ',' int | int. The recursive call at the
+// same position fails, so the rule matches a single int rather than looping.
+constexpr noam::parser left_recursive = noam::recurse<int>([](auto self) {
+    return noam::memo(noam::either(
+        noam::join(self, noam::literal<','>, noam::parse_int),
+        noam::parse_int));
+});
+
+int main() {
+    // Without a memo_table, parsers run normally
+    digit_tries = 0;
+    TEST(digit_then_suffix, "1?", '?', "");
+    all_passed = all_passed && digit_tries == 2;
+
+    {
+        noam::memo_table memo;
+        digit_tries = 0;
+        TEST(digit_then_suffix, "1?", '?', "");
+        all_passed = all_passed && digit_tries == 1;
+        // Failures are remembered too
+        all_passed = all_passed && !digit_then_suffix.parse("x");
+        all_passed = all_passed && noam::memo_table::current() == &memo;
+    }
+    all_passed = all_passed && noam::memo_table::current() == nullptr;
+
+    std::string input = "a";
+    for (int depth = 1; depth <= 24; depth++) {
+        input = "(" + input + ")";
+    }
+    {
+        noam::memo_table memo;
+        std::string with_rest = input + " rest";
+        TEST(nested, with_rest, 24, " rest");
+        TEST(nested, "((a)!)", 2, "");
+        TEST(nested, "((a))!x", 2, "x");
+        // One result per rule and position
+        all_passed = all_passed && memo.size() <= input.size() + 16;
+    }
+    TEST(nested, "((a))!x", 2, "x");
+
+    {
+        noam::memo_table memo;
+        TEST(left_recursive, "1,2", 1, ",2");
+    }
+
+    // Tables nest, and the inner table is used while it's installed
+    {
+        noam::memo_table outer;
+        {
+            noam::memo_table inner;
+            (void)digit_then_suffix.parse("1!");
+            all_passed = all_passed && inner.size() == 1 && outer.size() == 0;
+        }
+        all_passed = all_passed && noam::memo_table::current() == &outer;
+    }
+    return all_passed ? 0 : 1;
+}
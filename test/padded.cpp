@@ -0,0 +1,61 @@
+#include "test_helpers.hpp"
+#include <noam/intrinsics.hpp>
+#include <noam/padded.hpp>
+#include <string>
+
+/**
+ * @brief Checks that parsing every prefix of input gives the same result
+ * whether or not the input is padded. The padding is filled with characters
+ * the parser would accept, so that over-reading would be detected.
+ */
+void test_padded(
+    noam::state_t name,
+    auto&& parser,
+    std::string const& input,
+    char fill) {
+    bool passed = true;
+    for (size_t size = 0; size <= input.size(); size++) {
+        std::string prefix = input.substr(0, size);
+        noam::padded_buffer buffer(prefix);
+        std::memset(buffer.data() + size, fill, noam::input_padding);
+
+        auto expected = parser.parse(noam::state_t(prefix));
+        auto obtained = parser.parse(buffer.state());
+        size_t expected_offset = expected.get_state().data() - prefix.data();
+        size_t obtained_offset = obtained.get_state().data() - buffer.data();
+        passed = passed && bool(expected) == bool(obtained)
+              && (!expected
+                  || (expected.get_value() == obtained.get_value()
+                      && expected_offset == obtained_offset));
+    }
+    all_passed = all_passed && passed;
+    fmt::print(
+        R"(
+- name:      "{} with padding"
+  input:     {:?}
+  passed:    {}
+)",
+        name,
+        input,
+        passed);
+}
+
+int main() {
+    std::string spaces(100, ' ');
+    test_padded("whitespace", noam::whitespace, spaces + "x" + spaces, ' ');
+    test_padded("count_spaces", noam::count_spaces, spaces + "x", ' ');
+    test_padded("parse_line", noam::parse_line, spaces + "\r\nx\ny", '\n');
+    test_padded("parse_line", noam::parse_line, "abc\r", '\n');
+    test_padded("literal", noam::literal<"hello">, "hello world", 'o');
+    test_padded(
+        "literal_constant",
+        noam::literal_constant<true, "true">,
+        "true",
+        'e');
+    test_padded("parse_bool", noam::parse_bool, "false", 'e');
+    test_padded("literal", noam::literal<"HTTP/1.1">, "HTTP/1.1 200", '1');
+
+    TEST(noam::parse_line, noam::padded_buffer("ab\r\ncd"), "ab", "cd");
+    TEST(noam::count_spaces, noam::padded_buffer("   x"), 3, "x");
+    return all_passed ? 0 : 1;
+}
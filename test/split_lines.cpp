@@ -0,0 +1,78 @@
+#include "test_helpers.hpp"
+#include <array>
+#include <fmt/ranges.h>
+#include <noam/split_lines.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Splits the input with parse_line, one line at a time
+ */
+std::vector<std::string_view> parse_lines(noam::state_t input) {
+    std::vector<std::string_view> lines;
+    while (!input.empty()) {
+        auto line = noam::parse_line.parse(input);
+        lines.push_back(line.get_value());
+        input = line.get_state();
+    }
+    return lines;
+}
+
+void test_split_lines(std::string const& input) {
+    auto expected = parse_lines(input);
+
+    std::vector<std::string_view> lines;
+    noam::split_lines(input, lines);
+
+    // Split in batches of 3 lines at a time
+    std::vector<std::string_view> batched;
+    std::array<std::string_view, 3> batch;
+    noam::state_t rest = input;
+    for (;;) {
+        auto result = noam::split_lines(rest, batch);
+        batched.insert(
+            batched.end(),
+            batch.begin(),
+            batch.begin() + result.get_value());
+        rest = result.get_state();
+        if (rest.empty()) {
+            break;
+        }
+    }
+
+    bool passed = lines == expected && batched == expected;
+    all_passed = all_passed && passed;
+    fmt::print(
+        R"(
+- name:      "split_lines"
+  input:     {:?}
+  expected:  {}
+  obtained:  {}
+  batched:   {}
+  passed:    {}
+)",
+        input,
+        expected,
+        lines,
+        batched,
+        passed);
+}
+
+int main() {
+    test_split_lines("");
+    test_split_lines("\n");
+    test_split_lines("hello");
+    test_split_lines("hello\nworld\r\n\na longer line");
+    test_split_lines("hello\nworld\r\n\na longer line\n");
+    test_split_lines("\r\n\r\n\r\r\n");
+
+    std::string long_lines;
+    for (int i = 0; i < 50; i++) {
+        long_lines += std::string(i, 'x') + (i % 3 ? "\n" : "\r\n");
+    }
+    test_split_lines(long_lines);
+
+    noam::state_t first_line_removed = noam::state_t(long_lines).substr(2);
+    TEST(noam::parse_line, long_lines, std::string_view(), first_line_removed);
+    return all_passed ? 0 : 1;
+}
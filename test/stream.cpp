@@ -0,0 +1,94 @@
+#include "test_helpers.hpp"
+#include <fmt/ranges.h>
+#include <noam/combinators.hpp>
+#include <noam/intrinsics.hpp>
+#include <noam/stream.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+void test_stream(
+    std::string const& input,
+    size_t buffer_size,
+    noam::stream_status expected_status,
+    std::vector<std::string> expected) {
+    std::istringstream stream(input);
+    std::vector<std::string> lines;
+    auto result = noam::for_each_record(
+        stream,
+        noam::parse_line,
+        [&](std::string_view line) { lines.emplace_back(line); },
+        buffer_size);
+    bool passed = result.status == expected_status && lines == expected;
+    all_passed = all_passed && passed;
+    fmt::print(
+        R"(
+- name:      "for_each_record"
+  input:     {:?}
+  buffer:    {}
+  expected:  {}
+  obtained:  {}
+  passed:    {}
+)",
+        input,
+        buffer_size,
+        expected,
+        lines,
+        passed);
+}
+
+// Parses one integer per line
+constexpr auto parse_int_line =
+    noam::enclose(noam::match_spaces, noam::parse_int, noam::literal<'\n'>);
+
+void test_int_stream(
+    std::string const& input,
+    size_t buffer_size,
+    noam::stream_status expected_status,
+    size_t expected_records) {
+    std::istringstream stream(input);
+    auto result = noam::for_each_record(
+        stream,
+        parse_int_line,
+        [](int) {},
+        buffer_size);
+    bool passed = result.status == expected_status
+               && result.records == expected_records;
+    all_passed = all_passed && passed;
+    fmt::print(
+        R"(
+- name:      "for_each_record"
+  input:     {} bytes of integers
+  buffer:    {}
+  records:   {}
+  passed:    {}
+)",
+        input.size(),
+        buffer_size,
+        result.records,
+        passed);
+}
+
+int main() {
+    using noam::stream_status;
+    std::vector<std::string> lines {"hello", "world", "", "a longer line"};
+    std::string input = "hello\nworld\r\n\na longer line";
+    for (size_t buffer_size : {15, 16, 64, 4096}) {
+        test_stream(input, buffer_size, stream_status::ok, lines);
+        test_stream(input + "\n", buffer_size, stream_status::ok, lines);
+    }
+    test_stream(input, 8, stream_status::record_too_large, {"hello", "world", ""});
+    test_stream("", 16, stream_status::ok, {});
+
+    // Numbers split across refills are parsed once they're complete, and a
+    // malformed record is reported as soon as it's seen, even though there's
+    // more input after it
+    std::string ints;
+    for (int i = 0; i < 1000; i++) {
+        ints += std::to_string(i * 37) + "\n";
+    }
+    test_int_stream(ints, 16, stream_status::ok, 1000);
+    test_int_stream("1\n2\nx\n" + ints, 16, stream_status::parse_error, 2);
+    test_int_stream("1\n2\n3 x\n" + ints, 64, stream_status::parse_error, 2);
+    return all_passed ? 0 : 1;
+}